@@ -22,6 +22,7 @@ class DummyModelComponent;
 class ForcingComponent;
 class slrComponent;
 class HalocarbonComponent;
+class HalocarbonBankComponent;
 class SimpleNbox;
 class CarbonCycleSolver;
 class CH4Component;
@@ -60,6 +61,7 @@ public:
     virtual void visit( CarbonCycleSolver* c ) {}
     virtual void visit( SimpleNbox* c ) {}
     virtual void visit( HalocarbonComponent* c ) {}
+    virtual void visit( HalocarbonBankComponent* c ) {}
     virtual void visit( OHComponent* c ) {}
     virtual void visit( CH4Component* c ) {}
     virtual void visit( N2OComponent* c ) {}
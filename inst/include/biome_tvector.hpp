@@ -0,0 +1,267 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2014-2015  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef BIOME_TVECTOR_H
+#define BIOME_TVECTOR_H
+/*
+ *  biome_tvector.hpp - Per-biome values indexed by time.
+ *
+ *  The history of a biome-specific state variable (e.g. vegetation
+ *  carbon), as a dense date-by-biome table.  This replaces a tvector of
+ *  biome->value maps, which copied the whole map for every date recorded
+ *  and rewrote every date's map when a biome was created, deleted, or
+ *  renamed.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "h_exception.hpp"
+
+namespace Hector {
+
+/*! \brief Time vector of per-biome values.
+ *
+ *  The dates are kept in a sorted vector, and the values in a date-by-biome
+ *  table, one row per date, stored contiguously; a biome's column is found
+ *  through a biome-name->column table.  Recording a date (usually appending
+ *  a row) takes time proportional to the number of biomes, and truncating
+ *  constant time; creating or deleting a biome is proportional to the size
+ *  of the table, and renaming one is a table update.
+ *
+ *  Values go in and come out as biome->value maps, as for the component's
+ *  current state.  Every date has a value for every biome.
+ */
+template <class T_data>
+class biome_tvector {
+public:
+    typedef std::map<std::string, T_data> biome_map;
+
+    void set( double t, const biome_map& values );
+    biome_map get( double t ) const;
+    const T_data& get( double t, const std::string& biome ) const;
+    bool exists( double t ) const;
+
+    double firstdate() const;
+    double lastdate() const;
+    int size() const { return static_cast<int>( dates.size() ); }
+
+    void truncate( double t );
+
+    void add_biome( const std::string& biome, const T_data& init_value );
+    void remove_biome( const std::string& biome );
+    void rename_biome( const std::string& oldname, const std::string& newname );
+
+private:
+    //! Recorded dates, in order
+    std::vector<double> dates;
+
+    //! Column of each biome
+    std::map<std::string, size_t> columns;
+
+    //! Values: element [row * columns.size() + column]
+    std::vector<T_data> data;
+
+    size_t row( double t ) const;
+
+    typename std::map<std::string, size_t>::iterator add_column( const std::string& biome,
+                                                                  const T_data& init_value );
+
+    static double round( double t ) {
+        // as in tvector: round to the nearest half-integer, so that
+        // minute differences in representation don't matter
+        return 0.5 * ::round( 2.0 * t );
+    }
+};
+
+//-----------------------------------------------------------------------
+/*! \brief Row of a recorded date.
+ *  \exception h_exception If there is no data at the date.
+ */
+template <class T_data>
+size_t biome_tvector<T_data>::row( double t ) const {
+    t = round( t );
+    if( !dates.empty() && dates.back() == t )
+        return dates.size() - 1;
+    const std::vector<double>::const_iterator it = std::lower_bound( dates.begin(), dates.end(), t );
+    if( it == dates.end() || *it != t ) {
+        std::ostringstream errmsg;
+        errmsg << "No data at requested time= " << t << "\n";
+        H_THROW( errmsg.str() );
+    }
+    return it - dates.begin();
+}
+
+//-----------------------------------------------------------------------
+/*! \brief Record the values of every biome at time t.
+ *
+ *  Biomes in the map that are new get a column, with the default value at
+ *  the other dates.  Biomes missing from the map get the default value at
+ *  this date.
+ */
+template <class T_data>
+void biome_tvector<T_data>::set( double t, const biome_map& values ) {
+    t = round( t );
+    size_t r;
+    if( dates.empty() || t > dates.back() ) {
+        r = dates.size();
+        dates.push_back( t );
+        data.resize( dates.size() * columns.size() );
+    }
+    else {
+        const std::vector<double>::iterator it = std::lower_bound( dates.begin(), dates.end(), t );
+        r = it - dates.begin();
+        if( *it != t ) {
+            dates.insert( it, t );
+            data.insert( data.begin() + r * columns.size(), columns.size(), T_data() );
+        }
+    }
+
+    // Both maps are in name order, so walk them together
+    typename std::map<std::string, size_t>::iterator col = columns.begin();
+    for( typename biome_map::const_iterator it = values.begin(); it != values.end(); ++it ) {
+        for( ; col != columns.end() && col->first < it->first; ++col )
+            data[ r * columns.size() + col->second ] = T_data();
+        if( col == columns.end() || col->first != it->first )
+            col = add_column( it->first, T_data() );
+        data[ r * columns.size() + col->second ] = it->second;
+        ++col;
+    }
+    for( ; col != columns.end(); ++col )
+        data[ r * columns.size() + col->second ] = T_data();
+}
+
+//-----------------------------------------------------------------------
+/*! \brief The values of every biome at time t.
+ *  \exception h_exception If there is no data at the date.
+ */
+template <class T_data>
+typename biome_tvector<T_data>::biome_map biome_tvector<T_data>::get( double t ) const {
+    const T_data* const rowdata = &data[ 0 ] + row( t ) * columns.size();
+    biome_map values;
+    for( typename std::map<std::string, size_t>::const_iterator col = columns.begin(); col != columns.end(); ++col )
+        values.insert( values.end(), std::make_pair( col->first, rowdata[ col->second ] ) );
+    return values;
+}
+
+//-----------------------------------------------------------------------
+/*! \brief The value of one biome at time t.
+ *  \exception h_exception If there is no data at the date, or for the biome.
+ */
+template <class T_data>
+const T_data& biome_tvector<T_data>::get( double t, const std::string& biome ) const {
+    const typename std::map<std::string, size_t>::const_iterator col = columns.find( biome );
+    H_ASSERT( col != columns.end(), "Biome '" + biome + "' not found in data." );
+    return data[ row( t ) * columns.size() + col->second ];
+}
+
+//-----------------------------------------------------------------------
+/*! \brief Does data exist at time t?
+ */
+template <class T_data>
+bool biome_tvector<T_data>::exists( double t ) const {
+    t = round( t );
+    return std::binary_search( dates.begin(), dates.end(), t );
+}
+
+//-----------------------------------------------------------------------
+/*! \brief First recorded date.
+ */
+template <class T_data>
+double biome_tvector<T_data>::firstdate() const {
+    H_ASSERT( !dates.empty(), "no data" );
+    return dates.front();
+}
+
+//-----------------------------------------------------------------------
+/*! \brief Last recorded date.
+ */
+template <class T_data>
+double biome_tvector<T_data>::lastdate() const {
+    H_ASSERT( !dates.empty(), "no data" );
+    return dates.back();
+}
+
+//-----------------------------------------------------------------------
+/*! \brief Wipe all of the data after time t.
+ */
+template <class T_data>
+void biome_tvector<T_data>::truncate( double t ) {
+    t = round( t );
+    const size_t n = std::upper_bound( dates.begin(), dates.end(), t ) - dates.begin();
+    dates.resize( n );
+    data.resize( n * columns.size() );
+}
+
+//-----------------------------------------------------------------------
+/*! \brief Add a biome, with the same value at every recorded date.
+ *  \exception h_exception If the biome already exists.
+ */
+template <class T_data>
+void biome_tvector<T_data>::add_biome( const std::string& biome, const T_data& init_value ) {
+    H_ASSERT( !columns.count( biome ), "Biome '" + biome + "' already exists in data." );
+    add_column( biome, init_value );
+}
+
+template <class T_data>
+typename std::map<std::string, size_t>::iterator biome_tvector<T_data>::add_column( const std::string& biome,
+                                                                                    const T_data& init_value ) {
+    // Widen each row by one, at the end
+    const size_t ncols = columns.size();
+    std::vector<T_data> newdata( dates.size() * ( ncols + 1 ), init_value );
+    for( size_t r = 0; r < dates.size(); ++r )
+        std::copy( data.begin() + r * ncols, data.begin() + ( r + 1 ) * ncols,
+                   newdata.begin() + r * ( ncols + 1 ) );
+    data.swap( newdata );
+    return columns.insert( std::make_pair( biome, ncols ) ).first;
+}
+
+//-----------------------------------------------------------------------
+/*! \brief Remove a biome (a no-op if it doesn't exist).
+ */
+template <class T_data>
+void biome_tvector<T_data>::remove_biome( const std::string& biome ) {
+    const typename std::map<std::string, size_t>::iterator it = columns.find( biome );
+    if( it == columns.end() )
+        return;
+
+    // Close up each row, and renumber the columns after the removed one
+    const size_t c = it->second, ncols = columns.size();
+    columns.erase( it );
+    size_t out = 0;
+    for( size_t i = 0; i < data.size(); ++i ) {
+        if( i % ncols != c )
+            data[ out++ ] = data[ i ];
+    }
+    data.resize( out );
+    for( typename std::map<std::string, size_t>::iterator col = columns.begin(); col != columns.end(); ++col ) {
+        if( col->second > c )
+            --col->second;
+    }
+}
+
+//-----------------------------------------------------------------------
+/*! \brief Give a biome's values to a new name.
+ *  \exception h_exception If the old name doesn't exist or the new one does.
+ */
+template <class T_data>
+void biome_tvector<T_data>::rename_biome( const std::string& oldname, const std::string& newname ) {
+    const typename std::map<std::string, size_t>::iterator it = columns.find( oldname );
+    H_ASSERT( it != columns.end(), "Biome '" + oldname + "' not found in data." );
+    H_ASSERT( !columns.count( newname ), "Biome '" + newname + "' already exists in data." );
+    const size_t c = it->second;
+    columns.erase( it );
+    columns.insert( std::make_pair( newname, c ) );
+}
+
+}
+
+#endif
@@ -0,0 +1,127 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2014-2015  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+/*
+ *  calibration.hpp
+ *  hector
+ *
+ *  Parameter calibration against observations, in process.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include "h_exception.hpp"
+#include "unitval.hpp"
+
+namespace Hector {
+
+class Core;
+
+/*! \brief Markov chain Monte Carlo calibration of model parameters.
+ *
+ *  Samples the posterior distribution of a set of parameters given one or
+ *  more observed time series, with a random walk Metropolis sampler.  Each
+ *  chain has its own core, loaded from the scenario once and then rerun for
+ *  every proposal, so a proposal costs one model run and no parsing or
+ *  result copying: setting a parameter rewinds the core to its start date
+ *  (and reruns the spinup only if the parameter takes part in it), and only
+ *  the observed years are fetched.  Chains run in parallel, one per task on
+ *  a TaskPool.  Runs stop at the last observed year.
+ *
+ *      Calibration cal( "input/hector_rcp45.ini" );
+ *      cal.addParameter( D_ECS, U_DEGC, 1.0, 6.0, 3.0, 0.2 );
+ *      cal.addObservations( "input/constraints/tgav_historical.csv", "tgav_constrain",
+ *                           D_GLOBAL_TEMP, U_DEGC, 0.1, true );
+ *      cal.run( 4, 1000, 4, 1 );
+ *
+ *  The priors are uniform between each parameter's bounds; proposals
+ *  outside them are rejected without a model run.  The observation errors
+ *  are independent and normal, with one standard deviation per series.  A
+ *  model run that fails (throws) rejects the proposal.
+ *
+ *  Each chain's random numbers come from the seed and its index only, so
+ *  the samples do not depend on the number of threads.
+ */
+class Calibration {
+public:
+    Calibration( const std::string& scenario );
+
+    void addParameter( const std::string& name, unit_types units,
+                       double lower, double upper, double initial, double step );
+
+    void addObservations( const std::string& name, unit_types units,
+                          const std::vector<double>& dates, const std::vector<double>& values,
+                          double sigma, bool anomaly );
+    void addObservations( const std::string& filename, const std::string& column,
+                          const std::string& name, unit_types units,
+                          double sigma, bool anomaly );
+
+    void run( int nchains, int nsamples, int nthreads, unsigned long seed );
+
+    //! Sizes of the last run
+    int numParameters() const { return static_cast<int>( params.size() ); }
+    int numChains() const { return nchains; }
+    int numSamples() const { return nsamples; }
+
+    //! Samples of the last run: element [( chain * nsamples + i ) * nparams + p]
+    const std::vector<double>& getSamples() const { return samples; }
+
+    //! Log posterior density (up to a constant) of each sample, by chain
+    const std::vector<double>& getLogPosterior() const { return logPosterior; }
+
+    std::vector<double> getAcceptance() const;
+    std::vector<double> getRhat() const;
+
+    //! Model runs made, and proposals per second of wall time, in the last run
+    long getModelRuns() const { return modelRuns; }
+    double getSamplesPerSecond() const { return samplesPerSecond; }
+
+private:
+    //! Scenario (INI file or bundle) each chain's core is loaded from
+    std::string scenario;
+
+    //! A parameter to calibrate, with a uniform prior and a normal proposal
+    struct calibration_param {
+        std::string name;
+        unit_types units;
+        double lower, upper;
+        double initial;
+        double step;            //!< proposal standard deviation
+    };
+
+    //! An observed time series of one model output
+    struct calibration_series {
+        std::string name;
+        unit_types units;
+        std::vector<double> dates, values;
+        double sigma;           //!< observation error standard deviation
+        bool anomaly;           //!< compare changes since the first date
+    };
+
+    std::vector<calibration_param> params;
+    std::vector<calibration_series> series;
+
+    void runChain( int chain, unsigned long seed );
+    void setParameters( Core* core, const double* x ) const;
+    double logLikelihood( Core* core ) const;
+
+    // Results of the last run
+    int nchains, nsamples;
+    std::vector<double> samples;
+    std::vector<double> logPosterior;
+    std::vector<long> accepted;         //!< by chain
+    std::vector<long> chainRuns;        //!< by chain
+    long modelRuns;
+    double samplesPerSecond;
+};
+
+}
+
+#endif // CALIBRATION_H
@@ -15,6 +15,7 @@
  */
 
 #include <string>
+#include <vector>
 
 #include "imodel_component.hpp"
 #include "core.hpp"
@@ -100,6 +101,34 @@ public:
     //! method, which does nothing.
     virtual void record_state(double t) {}
 
+    //! Copy the model's full carbon state into a flat vector
+
+    //! \details Used by the solver's accelerated spinup, which
+    //! extrapolates the sequence of annual states toward the steady
+    //! state.  Unlike getCValues, this should include every carbon
+    //! store that has to settle during spinup (e.g. the individual
+    //! biome and ocean box pools).  The default implementation
+    //! provides no state, which disables the acceleration.
+    virtual void getSpinupState( std::vector<double>& x ) const { x.clear(); }
+
+    //! Move the model to an extrapolated state from getSpinupState
+
+    //! \details The model may decline (returning false), e.g. if the
+    //! state is unphysical.  It is responsible for conserving mass.
+    virtual bool setSpinupState( const std::vector<double>& x ) { return false; }
+
+    //! Is atmospheric CO2 prescribed from time t on?
+
+    //! \details If so, and the solver is in concentration-driven
+    //! mode, it integrates the time step ending at t with a single
+    //! fixed step instead of adaptively.  The model should then set
+    //! its atmosphere to the prescribed value in stashCValues, so
+    //! that the step's error only reaches the other pools.  This
+    //! should only be true if nothing outside the carbon cycle
+    //! depends on those pools for the rest of the run.  The default
+    //! implementation prescribes nothing.
+    virtual bool prescribedAtmosphere( double t ) const { return false; }
+
     // Create, delete, and rename biomes. These must be defined here
     // because some C cycle models (e.g. the ocean C cycle component)
     // will not have biomes, but are members of the `CarbonCycleModel`
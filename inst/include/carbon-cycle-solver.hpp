@@ -22,6 +22,9 @@
 
 #define MAX_CARBON_MODEL_RETRIES 8
 
+// Number of past spinup steps used by the accelerated (Anderson) spinup
+#define SPINUP_ACCEL_DEPTH 5
+
 namespace Hector {
   
 /*! \brief The carbon cycle solver component
@@ -100,6 +103,8 @@ private:
     double dt;
     
     unitval eps_spinup;     //! spinup epsilon (drift/tolerance), Pg C
+    bool spinup_accel;      //! accelerate spinup by extrapolating the pools?
+    bool conc_driven;       //! take one fixed step in years with prescribed CO2?
     
     struct bad_derivative_exception {
         bad_derivative_exception(const int status):errorFlag(status) { }
@@ -107,14 +112,27 @@ private:
     };
     // A functor to provide callbacks for the ODE solver. 
     struct ODEEvalFunctor {
-        ODEEvalFunctor( CarbonCycleModel* cmodel, double* time ):modelptr(cmodel), t(time) { }
+        ODEEvalFunctor( CarbonCycleModel* cmodel, double* time, long* evals ):modelptr(cmodel), t(time), nevals(evals) { }
         void operator()( const std::vector<double>& y, std::vector<double>& dydt, double t );
         void operator()( const std::vector<double>& y, double t );
         CarbonCycleModel* modelptr;
         double* t;
+        long* nevals;       //!< count of derivative evaluations (for profiling)
     };
+
+    //! The ODE stepper, kept between steps so its working space is reused
+    //! (created on first use; defined in the source file, to keep odeint
+    //! out of this header)
+    struct ode_stepper;
+    ode_stepper* stepper;
+    void dropStepper();
     
     void failure( int stat, double t0, double tmid );
+    bool fixed_step( double tnew, long* nevals );
+    double spinup_residual();
+    bool extrapolate_spinup();
+    static bool solve_linear( std::vector<std::vector<double> >& a,
+                              std::vector<double>& x );
     
     bool in_spinup;
     
@@ -130,6 +148,17 @@ private:
     std::vector<double> c_old;
     std::vector<double> c_new;
     std::vector<double> dcdt;
+
+    //! Accelerated spinup: the model state before and after the current
+    //! step, the same after the previous step, and the differences
+    //! between successive steps (most recent last)
+    std::vector<double> x_old;
+    std::vector<double> x_new;
+    std::vector<double> f_prev;
+    std::vector<double> g_prev;
+    std::vector<std::vector<double> > spinup_df;
+    std::vector<std::vector<double> > spinup_dg;
+    int nextrap;            //!< extrapolations taken in this spinup
 };
 
 }
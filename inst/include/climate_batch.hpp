@@ -0,0 +1,94 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2014-2015  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef CLIMATE_BATCH_HPP
+#define CLIMATE_BATCH_HPP
+/*
+ *  climate_batch.hpp
+ *  hector
+ *
+ *  Forcing and temperature for many scenarios at once.
+ *
+ */
+
+#include <vector>
+
+#include "doeclim.hpp"
+#include "dual.hpp"
+#include "forcing_component.hpp"
+
+namespace Hector {
+
+//! The climate parameters, in the order of the derivatives in a climate_dual
+enum climate_param { CLIMATE_S, CLIMATE_DIFF, CLIMATE_ALPHA, CLIMATE_VOLSCL, CLIMATE_NPARAMS };
+
+//! Dual numbers carrying the derivatives with respect to the climate parameters
+typedef dual<CLIMATE_NPARAMS> climate_dual;
+
+//------------------------------------------------------------------------------
+/*! \brief Forcing and temperature for a batch of concentration scenarios.
+ *
+ *  Runs the greenhouse gas forcing formulas of the ForcingComponent and the
+ *  DOECLIM model of the TemperatureComponent for many scenarios at once,
+ *  without a Core: the scenarios supply concentrations and the remaining
+ *  forcings directly, and share the climate parameters.  This is for
+ *  emulator-style use, where only the concentrations or forcings vary.
+ *
+ *  Inputs and results are year-by-scenario tables (element
+ *  [year * nscenarios + s]).  The first year is the base year: forcings are
+ *  relative to it, and the temperatures start from zero there, as in a full
+ *  model run.
+ *
+ *  T is the numeric type of the climate parameters and the temperatures.
+ *  With climate_dual parameters seeded by climate_dual::variable (index
+ *  from climate_param), one run also gives the exact derivatives of the
+ *  temperatures and heat fluxes with respect to those parameters, in place
+ *  of a finite-difference run per parameter.  The forcings don't depend on
+ *  them, and stay doubles.
+ */
+template<class T>
+class ClimateBatchT {
+public:
+    ClimateBatchT( T S, T diff, T alpha, T volscl, double M0, double N0 );
+
+    void run( size_t nyears, size_t nscenarios,
+              const double* co2, const double* ch4, const double* n2o,
+              const double* aerosol, const double* volcanic, const double* other );
+
+    //! Number of years and scenarios in the last run
+    size_t getYears() const { return nyears; }
+    size_t getScenarios() const { return n; }
+
+    const std::vector<double>& getForcing( ForcingComponent::forcing_index f ) const;
+
+    //! The temperature results
+    const DoeclimT<T>& getDoeclim() const { return doeclim; }
+
+private:
+    //! Climate sensitivity (deg C), ocean heat diffusivity (cm2/s), and
+    //! aerosol and volcanic forcing scaling (see TemperatureComponent)
+    T S, diff, alpha, volscl;
+
+    ForcingComponent::ch4_n2o_baseline ch4n2o;
+
+    size_t nyears, n;
+
+    //! Forcings relative to the base year, W/m2
+    std::vector<double> rfCO2, rfCH4, rfN2O, rfH2O, rfTotal;
+
+    //! Absolute CH4, N2O, and H2O forcings in the base year, and one year's
+    //! forcing as seen by DOECLIM
+    std::vector<double> baseCH4, baseN2O, baseH2O;
+    std::vector<T> effective;
+
+    DoeclimT<T> doeclim;
+};
+
+typedef ClimateBatchT<double> ClimateBatch;
+
+}
+
+#endif // CLIMATE_BATCH_HPP
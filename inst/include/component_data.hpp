@@ -25,9 +25,16 @@
 #define D_END_DATE              "endDate"
 #define D_DO_SPINUP             "do_spinup"
 #define D_MAX_SPINUP            "max_spinup"
+#define D_TIMESTEP              "timestep"
+#define D_PROFILE               "profile"
+#define D_THREADS               "threads"
+#define D_HALOCARBON_BANK       "halocarbon_bank"
 #define D_ENABLED               "enabled"
 #define D_OUTPUT_ENABLED        "output"
 
+// components that record histories (ocean, simpleNbox, halocarbons, slr)
+#define D_FLOAT_HISTORY         "float_history"
+
 // bc component
 #define D_EMISSIONS_BC          "BC_emissions"
 
@@ -36,6 +43,8 @@
 #define D_CCS_EPS_REL           "eps_rel"
 #define D_CCS_DT                "dt"
 #define D_EPS_SPINUP            "eps_spinup"
+#define D_SPINUP_ACCEL          "spinup_accel"
+#define D_CONC_DRIVEN           "concentration_driven"
 
 // forcing component
 #define D_RF_PREFIX             "F"
@@ -291,6 +300,7 @@
 #define D_BETA                  "beta"
 //#define D_SIGMA                 "sigma"
 #define D_WARMINGFACTOR         "warmingfactor"
+#define D_LAND_GRADIENT         "land_gradient"
 
 // slr component
 #define D_SL_RC                 "sl_rc"
@@ -29,6 +29,8 @@
 
 #define OCEAN_COMPONENT_NAME "ocean"
 
+#define HALOCARBON_BANK_COMPONENT_NAME "halocarbon_bank"
+
 /***
  * The name of a HC component is X_COMPONENT_BASE + HALOCARBON_EXTENSION
  * The name of a HC emissions var is X_COMPONENT_BASE + EMISSIONS_EXTENSION
@@ -15,19 +15,54 @@
  */
 
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <chrono>
+#include <mutex>
 
 #include "logger.hpp"
 #include "h_exception.hpp"
 #include "ivisitable.hpp"
+#include "unitval.hpp"
 
 namespace Hector {
 
-class unitval;
 struct message_data;
 class IModelComponent;
+class TaskPool;
+
+//------------------------------------------------------------------------------
+/*! \brief One line of the core's profiling summary.
+ *
+ *  category is one of "run", "spinup" (per-component time and calls),
+ *  "visitors", "message" (sendMessage calls by capability), "event"
+ *  (counters reported by components, e.g. solver RHS evaluations), or
+ *  "cache" (hits and misses of the getData message cache).
+ *  seconds is zero for the count-only categories.
+ */
+struct profile_entry {
+    std::string category;
+    std::string name;
+    long count;
+    double seconds;
+};
+
+//------------------------------------------------------------------------------
+/*! \brief One setData call, as seen by a core that is recording its inputs.
+ *
+ *  Used to compile a scenario into a binary bundle (see scenario_bundle.hpp).
+ *  Inputs from INI and CSV files always arrive as strings; values set as
+ *  unitvals are recorded in the same "value" + "units" form.
+ */
+struct recorded_input {
+    std::string component;
+    std::string name;
+    double date;
+    std::string value_str;
+    std::string units_str;
+};
 
 //------------------------------------------------------------------------------
 /*! \brief Core class.
@@ -61,6 +96,9 @@ public:
     IModelComponent* getComponentByCapability( const std::string& capabilityName
                                               ) const;
 
+    std::vector<IModelComponent*> getComponentsByInput( const std::string& inputName
+                                                       ) const;
+
     void registerCapability(const std::string& capabilityName, const std::string& componentName, bool warndupe=true
                             ) ;
 
@@ -79,6 +117,7 @@ public:
     double getStartDate() const { return startDate; };
     double getEndDate() const { return endDate; };
     double getCurrentDate() const {return lastDate;}
+    double getTimestep() const { return 1.0 / stepsPerYear; }
     std::string getRun_name() const { return run_name; };
     bool inSpinup() const { return in_spinup; };
     bool outputEnabled( std::string componentName ) { return std::find( disabledOutputComponents.begin(),
@@ -105,6 +144,25 @@ public:
     void deleteBiome(const std::string& biome);
     void renameBiome(const std::string& oldname, const std::string& newname);
 
+    //! Profiling of component run times and message/event counts
+    void setProfiling( bool enable ) { profiling = enable; }
+    bool isProfiling() const { return profiling; }
+    void countEvent( const std::string& eventName, long n = 1 );
+    std::vector<profile_entry> getProfile() const;
+    void resetProfile();
+
+    //! Rewinding after inputs are changed (see noteChange)
+    bool resetPending() const { return resetNeeded; }
+    double pendingResetDate() const { return respinNeeded ? 0.0 : resetToDate; }
+    void applyPendingReset();
+
+    //! Run components that don't exchange data concurrently within a year
+    void setThreads( int n );
+    int getThreads() const { return nthreads; }
+
+    //! Keep a copy of every setData call in the given list (null to stop)
+    void recordInputs( std::vector<recorded_input>* inputs ) { inputLog = inputs; }
+
 private:
     //! Registry of instantiated cores
     //! \details This is used when you are instantiating hector cores
@@ -153,6 +211,14 @@ private:
     //! Maximum number of spinup steps allowed.
     int max_spinup;
 
+    //------------------------------------------------------------------------------
+    //! Time steps per year (settable from input as the step length, in years).
+    //! Components that don't support the step run once a year.
+    int stepsPerYear;
+
+    //! Components that run at every step when it is shorter than a year
+    std::set<IModelComponent*> subannualComponents;
+
     //------------------------------------------------------------------------------
     //! A comparison object to ensure modelComponents are ordered according to
     //! dependencies.
@@ -219,10 +285,164 @@ private:
     //! Flag: are we currently in spinup mode?
     bool in_spinup;
 
+    //! Flag: are components being prepared to run?
+    bool in_prepare;
+
     //! List of visitors which may need to take action after a model time-step.
     std::vector<AVisitor*> modelVisitors;
     // Some helpful typedefs to clean up syntax
     typedef std::vector<AVisitor*>::iterator VisitorIterator;
+
+    //------------------------------------------------------------------------------
+    //! Flag (settable from input) to collect profiling data.
+    bool profiling;
+
+    //! Accumulated wall time and number of calls for one profiled item
+    struct profile_timing {
+        profile_timing() : calls( 0 ), seconds( 0.0 ) {}
+        long calls;
+        double seconds;
+    };
+    typedef std::chrono::steady_clock profile_clock;
+    void addTime( profile_timing& timing, const profile_clock::time_point& start );
+    void logProfile();
+
+    std::map<std::string, profile_timing> runTimes;     //!< Component run(), by component
+    std::map<std::string, profile_timing> spinupTimes;  //!< Component run_spinup(), by component
+    profile_timing visitorTime;                         //!< All visitors
+    std::map<std::string, long> messageCounts;          //!< sendMessage calls, by capability
+    std::map<std::string, long> eventCounts;            //!< Component-reported counters
+    long cacheHits, cacheMisses;                        //!< Message cache lookups
+
+    //! If not null, setData calls are appended here
+    std::vector<recorded_input>* inputLog;
+
+    //------------------------------------------------------------------------------
+    // Partial reruns.  The core watches the messages components exchange while
+    // they run, and which components are sent new data once the model has been
+    // set up.  reset() then resets only the changed components and the ones
+    // that depend on them; the others keep their results, and run() skips them
+    // until it has caught up with the date they were run to.
+    typedef std::pair<IModelComponent*, IModelComponent*> component_link;
+
+    //! The component whose run, spinup, or prepareToRun is in progress (if any)
+    IModelComponent* activeComponent;
+
+    //! Provider -> user links: data read, or dependencies registered
+    std::set<component_link> dataFlow;
+
+    //! User -> provider links for reads of the provider's current state
+    //! (mutable because getComponentByCapability records direct couplings)
+    mutable std::set<component_link> stateReads;
+
+    //! Components sent new data since the last reset
+    std::set<IModelComponent*> changedComponents;
+
+    //! Pairs of components holding pointers to each other
+    mutable std::set<component_link> directLinks;
+
+    //! Components that do work during the spinup
+    std::set<IModelComponent*> spinupComponents;
+
+    //! Components sent new parameter values, to be prepared again on reset
+    std::set<IModelComponent*> reprepareComponents;
+
+    //! Provider -> user links for data read while preparing to run
+    std::set<component_link> prepareReads;
+
+    //! Whether changed inputs require a reset before the next run, the date
+    //! to reset to, and whether the spinup must be rerun
+    bool resetNeeded;
+    double resetToDate;
+    bool respinNeeded;
+
+    void noteChange( IModelComponent* component, double date );
+    bool affectsSpinup( IModelComponent* component ) const;
+    std::set<IModelComponent*> prepareSet( const std::set<IModelComponent*>& changed ) const;
+
+    //! Components being rerun, and the date the others have been run to
+    std::set<IModelComponent*> rerunComponents;
+    double rerunUntil;
+
+    void noteMessage( const std::string& message, IModelComponent* provider,
+                      const message_data& info );
+    std::set<IModelComponent*> rerunSet() const;
+
+    //------------------------------------------------------------------------------
+    // Parallel runs.  Using the links above, the components are sorted into
+    // levels whose members don't exchange data with each other, so that each
+    // level depends only on the ones before it.  With more than one thread,
+    // the members of a level run concurrently on the task pool.  The links
+    // are only known once every component has run, so the first year after
+    // setup always runs in sequence.
+    int nthreads;
+    TaskPool* taskPool;
+
+    //! Components by level, each level in dependency order
+    std::vector<std::vector<IModelComponent*> > runLevels;
+
+    //! Number of links when runLevels was built
+    size_t scheduleLinks;
+
+    //! Whether a year has been run with all the links being recorded
+    bool linksObserved;
+
+    //! Components are running on the task pool, so the bookkeeping shared
+    //! between them must be locked
+    bool parallelRun;
+    mutable std::mutex trackingMutex;
+
+    void buildSchedule();
+    void runComponent( IModelComponent* component, double date );
+    void runParallel( double date, bool partial, bool yearEnd );
+    IModelComponent* currentComponent() const;
+
+    //------------------------------------------------------------------------------
+    //! Flag (settable from input) to run the halocarbons as one component.
+    bool halocarbonBank;
+
+    //! Components merged into another one: the component that took them over,
+    //! and the name qualifying their parameters there
+    typedef std::pair<IModelComponent*, std::string> merged_component;
+    std::map<std::string, merged_component> mergedComponents;
+
+    void mergeHalocarbons();
+
+    //------------------------------------------------------------------------------
+    // Message cache.  While the components run a year, getData responses are
+    // kept by datum and date, so a value asked for again in the same year
+    // is returned without going to the component that provides it.  A
+    // provider's values are dropped when it, or a component holding a
+    // pointer to it, finishes running or is sent data, and all of them at
+    // the start of every year.  Components reading their own data, or that
+    // of a component they hold a pointer to, are not served from it.
+    //
+    // Values are dropped by changing their provider's stamp, and their
+    // slots reused, so that the cache doesn't allocate once it has seen a
+    // year's messages.
+    struct cached_message {
+        double date;
+        unitval value;
+        IModelComponent* provider;
+        unsigned long stamp;            //!< provider's stamp when stored
+    };
+
+    //! Values by datum
+    std::map<std::string, std::vector<cached_message> > messageCache;
+
+    //! Current stamp of each provider's values
+    std::map<IModelComponent*, unsigned long> cacheStamps;
+
+    //! Whether the components are running a year, so the cache is in use
+    bool messageCacheActive;
+
+    bool cacheable( IModelComponent* provider ) const;
+    bool cachedMessage( const std::string& datum, double date,
+                        unitval& value, IModelComponent*& provider );
+    void cacheMessage( const std::string& datum, double date,
+                       const unitval& value, IModelComponent* provider );
+    void dropAllCachedMessages();
+    void dropCachedMessages( IModelComponent* provider );
 };
 
 }
@@ -0,0 +1,85 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2014-2015  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef CORE_COUPLER_H
+#define CORE_COUPLER_H
+/*
+ *  core_coupler.hpp
+ *  hector
+ *
+ *  Stepping interface for running Hector inside another model.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include "h_exception.hpp"
+#include "unitval.hpp"
+
+namespace Hector {
+
+class Core;
+class IModelComponent;
+
+/*! \brief Exchanges batches of inputs and outputs with a running core.
+ *
+ *  Intended for coupling Hector to an integrated assessment model (see
+ *  misc/main-api.cpp).  The caller registers the inputs it will supply and
+ *  the outputs it wants once, after the core has been initialized, and gets
+ *  back a handle (index) for each.  The component that handles each datum
+ *  is looked up at that point, so a coupling step does no name lookups or
+ *  string parsing:
+ *
+ *      CoreCoupler coupler( &core );
+ *      const int ffi = coupler.addInput( D_FFI_EMISSIONS, U_PGC_YR );
+ *      const int tgav = coupler.addOutput( D_GLOBAL_TEMP, U_DEGC );
+ *      core.prepareToRun();
+ *      ...
+ *      coupler.step( 5, inputs, outputs );     // advance five years
+ *
+ *  Buffers are owned by the caller and laid out one row per year, one
+ *  column per handle.  A step performs no heap allocation of its own.
+ *  Steps are whole years, even if the core's time step is shorter.
+ */
+class CoreCoupler {
+public:
+    CoreCoupler( Core* core );
+
+    int addInput( const std::string& datum, unit_types units );
+    int addOutput( const std::string& datum, unit_types units );
+
+    //! Number of values per year in the step() input and output buffers
+    int numInputs() const { return static_cast<int>( inputs.size() ); }
+    int numOutputs() const { return static_cast<int>( outputs.size() ); }
+
+    void step( int nyears, const double* inputValues, double* outputValues );
+
+private:
+    //! Weak reference to the core being driven
+    Core* core;
+
+    //! An input and the components that take it
+    struct coupled_input {
+        std::string datum;
+        unit_types units;
+        std::vector<IModelComponent*> components;
+    };
+
+    //! An output and the component that provides it
+    struct coupled_output {
+        std::string datum;
+        unit_types units;
+        IModelComponent* component;
+    };
+
+    std::vector<coupled_input> inputs;
+    std::vector<coupled_output> outputs;
+};
+
+}
+
+#endif // CORE_COUPLER_H
@@ -0,0 +1,135 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2014-2015  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef DOECLIM_HPP
+#define DOECLIM_HPP
+/*
+ *  doeclim.hpp
+ *  hector
+ *
+ *  The DOECLIM energy balance model, for one or more scenarios.
+ *
+ */
+
+#include <cstddef>
+#include <vector>
+
+namespace Hector {
+
+//------------------------------------------------------------------------------
+/*! \brief Diffusion Ocean Energy balance CLIMate model (DOECLIM).
+ *
+ *  Computes land and sea surface temperatures and ocean heat uptake from
+ *  radiative forcing (Kriegler, 2005; Tanaka and Kriegler, 2007), for any
+ *  number of scenarios that share the same climate parameters.  The
+ *  scenarios are stepped together, one year at a time; all of the results
+ *  are kept in year-by-scenario tables (element [tstep * n + s]), so that
+ *  each step is a set of loops over the scenarios.
+ *
+ *  The TemperatureComponent runs one scenario.  Each scenario's arithmetic
+ *  is independent of the others, so its results do not depend on how many
+ *  scenarios are run with it.
+ *
+ *  T is the numeric type of the parameters, forcings, and results: double
+ *  (the Doeclim type), or a dual number, which carries the derivatives of
+ *  the results with respect to the parameters and forcings.  The model is
+ *  instantiated for double and climate_dual (see climate_batch.hpp).
+ */
+template<class T>
+class DoeclimT {
+public:
+    DoeclimT();
+
+    void setup( T S, T diff, int nsteps, size_t nscenarios );
+
+    void step( int tstep, const T* forcing );
+
+    //! Number of timesteps and scenarios
+    int getSteps() const { return ns; }
+    size_t getScenarios() const { return n; }
+
+    //! Year-by-scenario results, valid for the steps run so far
+    const std::vector<T>& getForcing() const { return forcing; }
+    const std::vector<T>& getTemp() const { return temp; }
+    const std::vector<T>& getTempLandAir() const { return temp_landair; }
+    const std::vector<T>& getTempSST() const { return temp_sst; }
+    const std::vector<T>& getHeatFluxMixed() const { return heatflux_mixed; }
+    const std::vector<T>& getHeatFluxInterior() const { return heatflux_interior; }
+
+    // Hard-coded DOECLIM parameters
+    const int dt = 1;                     // years per timestep (this is implicit in Hector)
+    const double ak = 0.31;               // slope in climate feedback - land-sea heat exchange linear relationship
+    const double bk = 1.59;               // offset in climate feedback - land-sea heat exchange linear relationship, W/m2/K
+    const double csw = 0.13;              // specific heat capacity of seawater W*yr/m3/K
+    const double earth_area = 5100656E8;  // m2
+    const double kcon = 3155.0;           // conversion from cm2/s to m2/yr
+    const double q2co = 3.7;              // radiative forcing for atmospheric CO2 doubling, W/m2
+    const double rlam = 1.43;             // factor between land clim. sens. and sea surface clim. sens. T_L2x = rlam*T_S2x
+    const double secs_per_Year = 31556926.0;
+    const double zbot = 4000.0;           // bottom depth of diffusive ocean, m
+    const double bsi = 1.3;               // warming factor for marine surface air over SST (due to retreating sea ice)
+    const double cal = 0.52;               // heat capacity of land-troposphere system, W*yr/m2/K
+    const double cas = 7.80;              // heat capacity of mixed layer-troposphere system, W*yr/m2/K
+    const double flnd = 0.29;             // fractional land area
+    const double fso = 0.95;              // ocean fractional area below 60m
+
+private:
+    void invert_1d_2x2_matrix( T * x, T * y);
+
+    int ns;                  // number of timesteps
+    size_t n;                // number of scenarios
+
+    // DOECLIM parameters calculated from constants above
+    double ocean_area;       // m2
+    double cnum;             // factor from sea-surface climate sensitivity to global mean
+    double cden;             // intermediate parameter
+    T cfl;                   // land climate feedback parameter, W/m2/K
+    T cfs;                   // sea climate feedback parameter, W/m2/K
+    T kls;                   // land-sea heat exchange coefficient, W/m2/K
+    T keff;                  // ocean heat diffusivity, m2/yr
+    T taubot;                // ocean bottom diffusion time scale, yr
+    double powtoheat;        // convert flux to total ocean heat 1E22 m2*s
+    T taucfs;                // sea climate feedback time scale, yr
+    T taucfl;                // land climate feedback time scale, yr
+    T taudif;                // interior ocean heat uptake time scale, yr
+    T tauksl;                // sea-land heat exchange time scale, yr
+    T taukls;                // land-sea heat exchange time scale, yr
+
+    std::vector<T> KT0;
+    std::vector<T> KTA1;
+    std::vector<T> KTB1;
+    std::vector<T> KTA2;
+    std::vector<T> KTB2;
+    std::vector<T> KTA3;
+    std::vector<T> KTB3;
+
+    // Components of the difference equation system B*T(i+1) = Q(i) + A*T(i)
+    T B[4];
+    T C[4];
+    std::vector<T> Ker;
+    T A[4];
+    T IB[4];
+
+    // Year-by-scenario tables that are updated with each DOECLIM time-step
+    std::vector<T> temp;
+    std::vector<T> temp_landair;
+    std::vector<T> temp_sst;
+    std::vector<T> heatflux_mixed;
+    std::vector<T> heatflux_interior;
+    std::vector<T> heat_mixed;
+    std::vector<T> heat_interior;
+    std::vector<T> forcing;
+
+    // Per-scenario sums of the ocean diffusion kernel
+    std::vector<T> dpast;
+    std::vector<T> kerflux;
+};
+
+typedef DoeclimT<double> Doeclim;
+
+}
+
+#endif // DOECLIM_HPP
@@ -0,0 +1,148 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2014-2015  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef DUAL_HPP
+#define DUAL_HPP
+/*
+ *  dual.hpp
+ *  hector
+ *
+ *  Dual numbers for forward-mode automatic differentiation.
+ *
+ */
+
+#include <cmath>
+
+// The MinGW C++ compiler doesn't seem to pull in the cmath constants? (see #384)
+#ifndef M_PI
+#define M_PI       3.14159265358979323846
+#endif
+
+namespace Hector {
+
+//------------------------------------------------------------------------------
+/*! \brief A value and its derivatives with respect to N independent variables.
+ *
+ *  Arithmetic on dual numbers applies the chain rule as it goes, so code
+ *  written for a numeric type T computes exact derivatives along with its
+ *  results when T is a dual.  Seed each input with variable(); a plain
+ *  double converts to a constant (all derivatives zero).  Comparisons use
+ *  the value only.
+ */
+template<int N>
+class dual {
+public:
+    double v;           //!< value
+    double d[ N ];      //!< derivatives
+
+    dual( double x = 0.0 ) : v( x ) {
+        for( int i = 0; i < N; ++i ) d[ i ] = 0.0;
+    }
+
+    //! The i'th independent variable, with value x
+    static dual variable( double x, int i ) {
+        dual r( x );
+        r.d[ i ] = 1.0;
+        return r;
+    }
+
+    dual& operator+=( const dual& b ) {
+        v += b.v;
+        for( int i = 0; i < N; ++i ) d[ i ] += b.d[ i ];
+        return *this;
+    }
+    dual& operator-=( const dual& b ) {
+        v -= b.v;
+        for( int i = 0; i < N; ++i ) d[ i ] -= b.d[ i ];
+        return *this;
+    }
+    dual& operator*=( const dual& b ) {
+        for( int i = 0; i < N; ++i ) d[ i ] = d[ i ] * b.v + v * b.d[ i ];
+        v *= b.v;
+        return *this;
+    }
+    dual& operator/=( const dual& b ) {
+        v /= b.v;
+        for( int i = 0; i < N; ++i ) d[ i ] = ( d[ i ] - v * b.d[ i ] ) / b.v;
+        return *this;
+    }
+};
+
+template<int N> inline dual<N> operator-( const dual<N>& a ) {
+    dual<N> r( -a.v );
+    for( int i = 0; i < N; ++i ) r.d[ i ] = -a.d[ i ];
+    return r;
+}
+
+template<int N> inline dual<N> operator+( dual<N> a, const dual<N>& b ) { return a += b; }
+template<int N> inline dual<N> operator-( dual<N> a, const dual<N>& b ) { return a -= b; }
+template<int N> inline dual<N> operator*( dual<N> a, const dual<N>& b ) { return a *= b; }
+template<int N> inline dual<N> operator/( dual<N> a, const dual<N>& b ) { return a /= b; }
+
+// Mixed with doubles, which are constants
+template<int N> inline dual<N> operator+( dual<N> a, double b ) { a.v += b; return a; }
+template<int N> inline dual<N> operator+( double a, dual<N> b ) { b.v += a; return b; }
+template<int N> inline dual<N> operator-( dual<N> a, double b ) { a.v -= b; return a; }
+template<int N> inline dual<N> operator-( double a, const dual<N>& b ) { return -b + a; }
+template<int N> inline dual<N> operator*( dual<N> a, double b ) {
+    a.v *= b;
+    for( int i = 0; i < N; ++i ) a.d[ i ] *= b;
+    return a;
+}
+template<int N> inline dual<N> operator*( double a, const dual<N>& b ) { return b * a; }
+template<int N> inline dual<N> operator/( dual<N> a, double b ) {
+    a.v /= b;
+    for( int i = 0; i < N; ++i ) a.d[ i ] /= b;
+    return a;
+}
+template<int N> inline dual<N> operator/( double a, const dual<N>& b ) { return dual<N>( a ) / b; }
+
+template<int N> inline bool operator==( const dual<N>& a, const dual<N>& b ) { return a.v == b.v; }
+template<int N> inline bool operator!=( const dual<N>& a, const dual<N>& b ) { return a.v != b.v; }
+template<int N> inline bool operator<( const dual<N>& a, const dual<N>& b ) { return a.v < b.v; }
+template<int N> inline bool operator>( const dual<N>& a, const dual<N>& b ) { return a.v > b.v; }
+
+//------------------------------------------------------------------------------
+// Functions: the value, and its derivative dfdx times each derivative of x.
+// The overloads below would hide the standard ones from code in this
+// namespace, so those are brought in too.
+using std::exp;
+using std::log;
+using std::sqrt;
+using std::pow;
+using std::erf;
+
+template<int N> inline dual<N> chain( const dual<N>& x, double f, double dfdx ) {
+    dual<N> r( f );
+    for( int i = 0; i < N; ++i ) r.d[ i ] = dfdx * x.d[ i ];
+    return r;
+}
+
+template<int N> inline dual<N> exp( const dual<N>& x ) {
+    const double e = std::exp( x.v );
+    return chain( x, e, e );
+}
+template<int N> inline dual<N> log( const dual<N>& x ) {
+    return chain( x, std::log( x.v ), 1.0 / x.v );
+}
+template<int N> inline dual<N> sqrt( const dual<N>& x ) {
+    const double s = std::sqrt( x.v );
+    return chain( x, s, 0.5 / s );
+}
+template<int N> inline dual<N> pow( const dual<N>& x, double p ) {
+    return chain( x, std::pow( x.v, p ), p * std::pow( x.v, p - 1.0 ) );
+}
+template<int N> inline dual<N> erf( const dual<N>& x ) {
+    return chain( x, std::erf( x.v ), 2.0 / std::sqrt( M_PI ) * std::exp( -x.v * x.v ) );
+}
+
+//! The value of a double or a dual
+inline double value_of( double x ) { return x; }
+template<int N> inline double value_of( const dual<N>& x ) { return x.v; }
+
+}
+
+#endif // DUAL_HPP
@@ -14,9 +14,12 @@
  *
  */
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include "imodel_component.hpp"
 #include "tseries.hpp"
-#include "tvector.hpp"
 
 namespace Hector {
 
@@ -59,22 +62,73 @@ public:
     //! IVisitable methods
     virtual void accept( AVisitor* visitor );
 
-    //! A list (map) of all computed forcings, with associated iterator
-    typedef std::map<std::string, unitval > forcings_t;
-    typedef std::map<std::string, unitval >::iterator forcingsIterator;
+    //! The forcing agents.  Each year's forcings are stored in this order.
+    enum forcing_index {
+        FORCING_CO2,
+        FORCING_T_ALBEDO,
+        FORCING_CH4,
+        FORCING_N2O,
+        FORCING_H2O_STRAT,
+        FORCING_O3_TROP,
+        FORCING_HALO,               //!< first of the N_HALO_FORCINGS halocarbons
+        FORCING_BC = FORCING_HALO + N_HALO_FORCINGS,
+        FORCING_OC,
+        FORCING_SO2d,
+        FORCING_SO2i,
+        FORCING_VOL,
+        FORCING_TOTAL,
+        N_FORCINGS
+    };
+
+    //! Preindustrial CH4 and N2O concentrations (ppbv), with the terms of
+    //! the CH4 and N2O forcings that depend only on them
+    struct ch4_n2o_baseline {
+        void set( double M0, double N0 );
+        double M0, N0, sqrtM0, sqrtN0, fM0N0;
+    };
+
+    // Forcing formulas, for n values (e.g. scenarios) at a time
+    static void co2Forcing( size_t n, const double* Ca, const double* C0,
+                            double* Fco2 );
+    static void ch4N2OForcing( size_t n, const ch4_n2o_baseline& base,
+                               const double* Ma, const double* Na,
+                               double* Fch4, double* Fn2o, double* Fh2o );
 
 private:
     virtual unitval getData( const std::string& varName,
                             const double valueIndex );
 
-    //! Base year forcings
-    forcings_t baseyear_forcings;
-    //! Forcings by year
-    tvector<forcings_t> forcings_ts;
+    void resolveConstants();
+
+    //! Forcing names (e.g. FCO2), and index by name; the adjusted halocarbon
+    //! names map to the same index as the raw ones
+    std::vector<std::string> forcing_names;
+    std::map<std::string, int> forcing_index_map;
+
+    //! Which forcings the model computes (this depends only on which
+    //! components are enabled), set in prepareToRun
+    bool present[ N_FORCINGS ];
+    //! The present forcings, in name order.  This is the order they are
+    //! summed in and written out in.
+    std::vector<int> present_forcings;
+
+    //! Base year forcings, and whether they have been computed
+    double baseyear_forcings[ N_FORCINGS ];
+    bool have_baseyear_forcings;
+
+    //! Forcings relative to the base year, W/m2: one row of N_FORCINGS per
+    //! year from the base year, valid through currentYear
+    std::vector<double> forcing_table;
 
     double baseyear;        //! Year which forcing calculations will start
     double currentYear;     //! Tracks current year
-    unitval C0;             //! Records base year atmospheric CO2
+    double C0;              //! Records base year atmospheric CO2, ppmv
+
+    //! Preindustrial CH4 and N2O (with the terms that depend only on them),
+    //! 2000 and natural SO2 emissions, and the scaling of the indirect SO2
+    //! forcing.  These are read from the other components at the base year.
+    ch4_n2o_baseline ch4n2o;
+    double S0, SN, so2i_scale;
 
     tseries<unitval> Ftot_constrain;       //! Total forcing can be supplied
 
@@ -83,7 +137,6 @@ private:
 
     static const char *adjusted_halo_forcings[]; //! Capability strings for halocarbon forcings
     static const char *halo_forcing_names[];  //! Internal names of halocarbon forcings
-    static std::map<std::string, std::string> forcing_name_map;
 };
 
 }
@@ -26,6 +26,36 @@ void spline_forsythe( int, double *, double *, double *, double *, double * );
 double seval_forsythe( int, double, double *, double *, double *, double *, double * );
 double seval_deriv_forsythe( int, double, double *, double *, double *, double *, double * );
 
+//-----------------------------------------------------------------------
+/*! \brief The interpolating function over one interval.
+ *
+ *  The piece of an interpolator's function between two neighbouring data
+ *  points, for evaluating it many times inside that interval without a
+ *  search.  f() gives the same values as h_interpolator::f() there, and
+ *  the data values at the ends.  An interval built by the default
+ *  constructor is empty.
+ */
+struct interp_interval {
+    interpolation_methods method;
+    double x0, x1;          //!< ends of the interval
+    double y0, y1;          //!< data values at the ends
+    double dx, dy;          //!< differences between the ends (LINEAR)
+    double b, c, d;         //!< spline coefficients (SPLINE_FORSYTHE)
+
+    interp_interval() : method( DEFAULT ), x0( 0.0 ), x1( -1.0 ) {}
+
+    bool contains( double x ) const { return x >= x0 && x <= x1; }
+
+    double f( double x ) const {
+        if( x == x0 ) return y0;
+        if( x == x1 ) return y1;
+        if( method == LINEAR )
+            return y0 + ( x - x0 ) * dy / dx;
+        const double u = x - x0;
+        return y0 + u * ( b + u * ( c + u * d ) );
+    }
+};
+
 //-----------------------------------------------------------------------
 /*! \brief interpolator class header.
  *
@@ -56,6 +86,7 @@ public:
     double f( double );
     double f_deriv( double );
     void newdata( int, double*, double* );
+    void interval( double, interp_interval& );
     void set_method( interpolation_methods );
 };
 
@@ -0,0 +1,38 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2014-2015  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef H_PATH_HPP_
+#define H_PATH_HPP_
+/*
+ *  h_path.hpp
+ *  hector
+ *
+ *  Minimal file path handling, shared by the standalone and R builds.
+ *
+ *  The R package can't link against boost::filesystem, and calling back
+ *  into R for every path is slow, so these are implemented directly on
+ *  the C library.
+ */
+
+#include <string>
+
+namespace Hector {
+
+bool path_exists( const std::string& path );
+
+bool is_directory( const std::string& path );
+
+bool create_directory( const std::string& path );
+
+std::string parent_path( const std::string& path );
+
+std::string join_path( const std::string& dir, const std::string& path );
+
+std::string resolve_input_path( const std::string& path, const std::string& relativeTo );
+
+}
+
+#endif // H_PATH_HPP_
@@ -0,0 +1,126 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2014-2015  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef HALOCARBON_BANK_HPP
+#define HALOCARBON_BANK_HPP
+/*
+ *  halocarbon_bank.hpp
+ *  hector
+ *
+ *  All of the halocarbons in one component.
+ *
+ */
+
+#include <map>
+#include <vector>
+
+#include "logger.hpp"
+#include "tseries.hpp"
+#include "unitval.hpp"
+#include "imodel_component.hpp"
+
+namespace Hector {
+
+class HalocarbonComponent;
+
+//------------------------------------------------------------------------------
+/*! \brief Model component holding every halocarbon at once.
+ *
+ *  Runs the same decay model as HalocarbonComponent, but for all of the gases
+ *  together: parameters are kept one array per parameter, and concentrations,
+ *  emissions, and constraints in year-by-gas tables, so that each year is a
+ *  single loop over the gases.  Emissions and constraints are looked up once
+ *  in prepareToRun rather than every year.
+ *
+ *  The bank is built by the core from the per-gas components (see the
+ *  halocarbon_bank setting).  It takes over their capabilities and inputs,
+ *  and keeps the components themselves to parse and hold each gas's data.
+ *  Per-gas variables keep their usual names (e.g. CF4_emissions, FCF4);
+ *  per-gas parameters are named <gas>.<parameter>, e.g. CF4.tau.
+ */
+class HalocarbonBankComponent : public IModelComponent {
+    friend class CSVOutputStreamVisitor;
+
+public:
+    HalocarbonBankComponent();
+    virtual ~HalocarbonBankComponent();
+
+    const std::string& addGas( HalocarbonComponent* hc );
+
+    // IModelComponent methods
+    virtual std::string getComponentName() const;
+
+    virtual void init( Core* core );
+
+    virtual unitval sendMessage( const std::string& message,
+                                const std::string& datum,
+                                const message_data info=message_data() );
+
+    virtual void setData( const std::string& varName,
+                          const message_data& data );
+
+    virtual void prepareToRun();
+
+    virtual void run( const double runToDate );
+
+    virtual void reset(double time);
+
+    virtual void shutDown();
+
+    // IVisitable methods
+    virtual void accept( AVisitor* visitor );
+
+private:
+    virtual unitval getData( const std::string& varName,
+                            const double valueIndex );
+
+    //! Kinds of per-gas variable
+    enum gas_var { GAS_RF, GAS_CONCENTRATION, GAS_OTHER };
+
+    gas_var parseVar( const std::string& varName, size_t& gas, size_t& gasVarStart ) const;
+    size_t row( double date ) const;
+    void ensureRows( double date );
+    void sampleInputs( size_t gas, size_t firstRow );
+
+    //! The per-gas components, which hold the parameters and inputs
+    std::vector<HalocarbonComponent*> gases;
+    std::vector<std::string> gasNames;
+
+    //! Gas index by gas name, and gas index and kind by the name of each
+    //! per-gas variable
+    std::map<std::string, size_t> gasIndex;
+    std::map<std::string, std::pair<size_t, gas_var> > varIndex;
+
+    //! Per-gas parameters, copied in prepareToRun (see HalocarbonComponent)
+    std::vector<double> tau;
+    std::vector<double> rho;            //!< W/m2/pptv
+    std::vector<double> molarMass;
+
+    //! Per-gas decay factors, exp(-1/tau) and 1-exp(-1/tau)
+    std::vector<double> expfac;
+    std::vector<double> uptake;
+
+    //! Year-by-gas tables, one row per year from the start date.
+    //! Concentrations (pptv) are valid through oldDate.  Emissions (Gg) are
+    //! NaN where the gas is concentration-forced, and constraints (pptv) are
+    //! NaN where it isn't.
+    std::vector<double> conc;
+    std::vector<double> emiss;
+    std::vector<double> constr;
+    size_t nrows;
+
+    //! Gases sent new inputs since their rows were last filled in
+    std::vector<bool> inputsChanged;
+
+    Logger logger;
+
+    Core *core;
+    double oldDate;
+};
+
+}
+
+#endif // HALOCARBON_BANK_HPP
@@ -16,6 +16,7 @@
 
 #include "logger.hpp"
 #include "tseries.hpp"
+#include "history_tseries.hpp"
 #include "unitval.hpp"
 #include "imodel_component.hpp"
 
@@ -30,6 +31,7 @@ namespace Hector {
  */
 class HalocarbonComponent : public IModelComponent {
     friend class CSVOutputStreamVisitor;
+    friend class HalocarbonBankComponent;
 
 public:
     HalocarbonComponent( std::string g );
@@ -72,11 +74,11 @@ private:
     //! Radiative forcing efficiency [W/m^2/pptv]
     unitval rho;
 
-    //! Forcing [W/m^2]
-    tseries<unitval> hc_forcing;
+    //! Forcing [W/m^2] (for output only, so it may be stored in single precision)
+    history_tseries hc_forcing;
 
     tseries<unitval> emissions;     //! Time series of emissions, pptv
-    tseries<unitval> Ha_ts;         //! Time series of (ambient) concentration, pptv
+    history_tseries Ha_ts;          //! Time series of (ambient) concentration, pptv
     tseries<unitval> Ha_constrain; //! Concentration constraint, pptv
     unitval H0;                     //! Preindustrial concentration, pptv
 
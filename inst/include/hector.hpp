@@ -30,12 +30,18 @@
 
 /* Core functions */
 #include "core.hpp"
+#include "core_coupler.hpp"
 
 /* Setup functions */
 #include "ini_to_core_reader.hpp"
+#include "scenario_bundle.hpp"
 
 /* Output functions */
 #include "csv_outputstream_visitor.hpp"
 
+/* Batch forcing and temperature */
+#include "climate_batch.hpp"
+#include "calibration.hpp"
+
 
 #endif
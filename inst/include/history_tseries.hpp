@@ -0,0 +1,98 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2014-2015  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef HISTORY_TSERIES_H
+#define HISTORY_TSERIES_H
+/*
+ *  history_tseries.hpp - Recorded values of a quantity, indexed by time.
+ *
+ *  A component's record of one of its variables, set once per time step
+ *  and read back by date (for output, or when the component is reset).
+ *  Such histories were tseries, which keep a map node of about 80 bytes
+ *  for every date; here the values are kept in a plain array, with the
+ *  dates implied when they are consecutive years, and can optionally be
+ *  stored in single precision.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include "unitval.hpp"
+
+namespace Hector {
+
+//! Storage of a history's values
+enum history_precision {
+    HISTORY_DOUBLE,     //!< exact
+    HISTORY_FLOAT       //!< rounded to single precision
+};
+
+/*! \brief Time series of recorded values, stored densely.
+ *
+ *  The get/set/exists/truncate interface is that of tseries for dates that
+ *  have been recorded (a single value answers for any date, as in tseries);
+ *  there is no interpolation.  All the values share the units of the first
+ *  one set.
+ *
+ *  The dates are kept as runs of consecutive years (usually one for the
+ *  spinup and one for the run), so a value takes 8 bytes in double
+ *  precision and 4 in single.
+ *
+ *  Single precision rounds each value to the nearest float: the relative
+ *  error of a value read back is at most 2^-24 (about 6e-8), for magnitudes
+ *  between about 1e-38 and 3e38.  It is meant for diagnostic histories
+ *  that the model doesn't read back itself, so that the results of the
+ *  integration, and of a rerun after a reset, are unchanged.
+ */
+class history_tseries {
+public:
+    history_tseries();
+
+    void set( double t, const unitval& v );
+    unitval get( double t ) const;
+    bool exists( double t ) const;
+
+    double firstdate() const;
+    double lastdate() const;
+    int size() const { return n; }
+
+    void truncate( double t );
+
+    void set_precision( history_precision p );
+    history_precision get_precision() const { return precision; }
+
+    std::string name;
+
+private:
+    //! Number of values
+    int n;
+    //! Runs of consecutive years: the date of the first value of each run,
+    //! and its position; a run ends where the next one starts
+    struct date_run {
+        double start;
+        int first;
+    };
+    std::vector<date_run> runs;
+
+    unit_types units;
+    history_precision precision;
+    //! Values, in whichever of these the precision calls for
+    std::vector<double> dvalues;
+    std::vector<float> fvalues;
+
+    int index( double t ) const;
+    int count_through( double t ) const;
+    int run_length( size_t r ) const;
+    double value( int i ) const;
+    void store( int i, double x );
+    std::vector<double> all_dates() const;
+    void set_dates( const std::vector<double>& dates );
+};
+
+}
+
+#endif // HISTORY_TSERIES_H
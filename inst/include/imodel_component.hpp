@@ -112,6 +112,19 @@ public:
      */
     virtual void run( const double runToDate ) = 0;
 
+    //------------------------------------------------------------------------------
+    /*! \brief Whether the component can run in time steps of the given length.
+     *
+     *  When the core's time step is shorter than a year, components that
+     *  support it are run at every step, and the others once a year (so
+     *  run() always advances them by one year).  Most components keep annual
+     *  histories, and simply inherit the implementation below.
+     *
+     *  \param dt  The step length, in years (1/n of a year).
+     *  \return    A bool indicating whether the component can run in steps of dt.
+     */
+    virtual bool supportsTimestep( const double dt ) const { return dt == 1.0; }
+
     //------------------------------------------------------------------------------
     /*! \brief Run the component in spinup mode.
      *
@@ -14,6 +14,7 @@
  *
  */
 
+#include <ctime>
 #include <iostream>
 #include <fstream>
 
@@ -22,6 +23,17 @@
 #define LOG_DIRECTORY "logs/"
 #define LOG_EXTENSION ".log"
 
+/*!
+ * \brief Build-time minimum log level.
+ *
+ *  H_LOG statements below this level (0=DEBUG, 1=NOTICE, 2=WARNING,
+ *  3=SEVERE) are compiled out entirely.  Override on the compiler command
+ *  line, e.g. -DH_LOG_MIN_LEVEL=2 (see LOGFLOOR in makefile.standalone).
+ */
+#ifndef H_LOG_MIN_LEVEL
+#define H_LOG_MIN_LEVEL 0
+#endif
+
 namespace Hector {
 
 //------------------------------------------------------------------------------
@@ -61,12 +73,17 @@ private:
     //! If false this logger does not log regardless of log level provided.
     bool enabled;
 
-    //! The actual output stream which will handle the logging.
-    std::ostream loggerStream;
+    //! Flag to indicate that file output goes to the binary backend.
+    bool binary;
 
-    static const std::string& logLevelToStr( const LogLevel logLevel );
+    //! Id of this logger in the binary log (if binary is set).
+    unsigned short binaryId;
 
-    static const char* getDateTimeStamp();
+    //! Backend selection for loggers opened from now on.
+    static bool useBinaryBackend;
+
+    //! The actual output stream which will handle the logging.
+    std::ostream loggerStream;
 
     static void chk_logdir(std::string dir);
 
@@ -102,7 +119,16 @@ public:
     void open( const std::string& logName, bool echoToScreen,
                bool echoToFile, LogLevel minLogLevel );
 
-    bool shouldWrite( const LogLevel writeLevel ) const;
+    //------------------------------------------------------------------------------
+    /*! \brief Indicate whether a message at the given priority will be logged.
+     *  \param writeLevel The priority level to check.
+     *  \return True if this level would be logged, false otherwise.
+     *  \note Defined inline so that the H_LOG check for a disabled level costs
+     *        a couple of comparisons instead of a function call.
+     */
+    bool shouldWrite( const LogLevel writeLevel ) const {
+        return enabled && writeLevel >= minLogLevel;
+    }
 
     std::ostream& write( const LogLevel writeLevel,
                         const std::string& functionInfo );
@@ -120,6 +146,18 @@ public:
     bool isEnabled() const {
         return enabled;
     }
+
+    static void setBinaryBackend( bool useBinary ) {
+        useBinaryBackend = useBinary;
+    }
+
+    static bool getBinaryBackend() {
+        return useBinaryBackend;
+    }
+
+    static const std::string& logLevelToStr( const LogLevel logLevel );
+
+    static const char* getDateTimeStamp( time_t rawtime = time( 0 ) );
 };
 
 }
@@ -136,14 +174,16 @@ public:
 /*! \brief Macro to perform logging.
  *
  *  This macro will check if the logging level qualifies to be logged.  If not
- *  the no more processing will be done.  Otherwise it will fill in the name of
- *  the function and return a reference to the output stream so the rest of the
- *  message may be logged.
+ *  the no more processing will be done (in particular, the streamed arguments
+ *  are never evaluated).  Otherwise it will fill in the name of the function
+ *  and return a reference to the output stream so the rest of the message may
+ *  be logged.  Levels below H_LOG_MIN_LEVEL fail a constant test and the whole
+ *  statement is removed by the compiler.
  *
  * \param log An instance of the logger to log to.
  * \param level The logging priority to log at.
  */
 #define H_LOG(log, level)  \
-if( log.shouldWrite( level ) ) log.write( level, __func__ )
+if( ( level ) < H_LOG_MIN_LEVEL || !log.shouldWrite( level ) ) ; else log.write( level, __func__ )
 
 #endif
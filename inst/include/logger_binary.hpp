@@ -0,0 +1,111 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2014-2015  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef LOGGER_BINARY_H
+#define LOGGER_BINARY_H
+/*
+ *  logger_binary.hpp
+ *  hector
+ *
+ *  Binary, asynchronous backend for Logger.
+ *
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdint.h>
+
+#define BINARY_LOG_NAME "hector"
+#define BINARY_LOG_EXTENSION ".hlog"
+#define BINARY_LOG_MAGIC "HLOGBIN1"     //!< first 8 bytes of every binary log
+
+/*!
+ * \brief Record types in a binary log.
+ *
+ *  Every record starts with a 32-bit length (of the whole record, including
+ *  the length itself) and a one-byte type, all in host byte order.
+ *
+ *  - BINARY_LOG_NAME_RECORD: uint16 logger id, then the logger name.
+ *  - BINARY_LOG_EVENT_RECORD: uint8 level, uint16 logger id, int64 time
+ *    (seconds since the epoch), uint8 function name length, the function
+ *    name, then the message text.
+ */
+#define BINARY_LOG_NAME_RECORD 1
+#define BINARY_LOG_EVENT_RECORD 2
+
+namespace Hector {
+
+//------------------------------------------------------------------------------
+/*! \brief Process-wide sink for binary log records.
+ *
+ *  Each thread formats its messages into its own record buffer and, when a
+ *  record is complete, copies it into a single-producer/single-consumer ring
+ *  owned by that thread.  No locks are taken on this path.  A background
+ *  thread drains all of the rings into one file in the log directory.  Use
+ *  hector-logdecode to turn that file back into the usual text logs.  When a
+ *  thread exits its ring is drained and handed to the next new thread, so
+ *  there are only as many rings as threads that have logged at once.
+ */
+class BinaryLogSink {
+public:
+    static BinaryLogSink& instance();
+
+    ~BinaryLogSink();
+
+    uint16_t registerLogger( const std::string& logName );
+
+    std::ostream& begin( uint16_t loggerId, int level,
+                         const std::string& functionInfo );
+
+    void flush();
+
+    //! Size of each per-thread ring, in bytes.
+    static const size_t RING_SIZE = 1 << 16;
+
+    class Ring;
+
+private:
+    BinaryLogSink();
+    BinaryLogSink( const BinaryLogSink& );
+    BinaryLogSink& operator=( const BinaryLogSink& );
+
+    void openFile();
+    void drainLoop();
+    void drainAll();
+
+    Ring* threadRing();
+    void releaseRing( Ring* ring );
+    friend class RecordBuf;
+
+    //! Output file, opened on first registration.
+    std::FILE* out;
+
+    //! Protects the file, the ring list, and the logger id counter.
+    std::mutex fileMutex;
+
+    //! Used to wake the drain thread early when a ring fills up.
+    std::condition_variable wake;
+
+    std::vector<std::shared_ptr<Ring> > rings;
+
+    uint16_t nextId;
+
+    std::atomic<bool> stopping;
+
+    std::thread drainer;
+};
+
+}
+
+#endif // LOGGER_BINARY_H
@@ -17,6 +17,7 @@
 #include "logger.hpp"
 #include "tseries.hpp"
 #include "tvector.hpp"
+#include "history_tseries.hpp"
 #include "unitval.hpp"
 #include "carbon-cycle-model.hpp"
 #include "ocean_csys.hpp"
@@ -74,6 +75,8 @@ public:
     void slowparameval( double t, const double c[] );
     void stashCValues( double t, const double c[] );
     void record_state(double t);
+    void getSpinupState( std::vector<double>& x ) const;
+    bool setSpinupState( const std::vector<double>& x );
 
     void run1( const double runToDate );
 
@@ -148,30 +151,31 @@ private:
     tvector<oceanbox> inter_tv;
     tvector<oceanbox> deep_tv;
 
-    // Ocean conditions over time
-    tseries<unitval> Tgav_ts;
-    tseries<unitval> annualflux_sum_ts;
-    tseries<unitval> annualflux_sumHL_ts;
-    tseries<unitval> annualflux_sumLL_ts;
-    tseries<unitval> lastflux_annualized_ts;
-    tseries<unitval> Ca_ts;
-    tseries<unitval> Ca_HL_ts;
-    tseries<unitval> Ca_LL_ts;
-    tseries<unitval> C_IO_ts;
-    tseries<unitval> C_DO_ts;
-    tseries<unitval> PH_HL_ts;
-    tseries<unitval> PH_LL_ts;
-    tseries<unitval> pco2_HL_ts;
-    tseries<unitval> pco2_LL_ts;
-    tseries<unitval> dic_HL_ts;
-    tseries<unitval> dic_LL_ts;
-    tseries<unitval> temp_HL_ts;
-    tseries<unitval> temp_LL_ts;
-    tseries<unitval> co3_HL_ts;
-    tseries<unitval> co3_LL_ts;
-
-
-
+    // Ocean conditions over time (read back on reset)
+    history_tseries Tgav_ts;
+    history_tseries annualflux_sum_ts;
+    history_tseries annualflux_sumHL_ts;
+    history_tseries annualflux_sumLL_ts;
+    history_tseries lastflux_annualized_ts;
+    history_tseries Ca_ts;
+
+    // Diagnostics over time (for output only; these can be stored in
+    // single precision, see set_history_precision)
+    history_tseries Ca_HL_ts;
+    history_tseries Ca_LL_ts;
+    history_tseries C_IO_ts;
+    history_tseries C_DO_ts;
+    history_tseries PH_HL_ts;
+    history_tseries PH_LL_ts;
+    history_tseries pco2_HL_ts;
+    history_tseries pco2_LL_ts;
+    history_tseries dic_HL_ts;
+    history_tseries dic_LL_ts;
+    history_tseries temp_HL_ts;
+    history_tseries temp_LL_ts;
+    history_tseries co3_HL_ts;
+    history_tseries co3_LL_ts;
+    void set_history_precision( history_precision p );
 
     // timestep control
     tseries<double> max_timestep_ts;
@@ -27,6 +27,7 @@
 #include "ocean_csys.hpp"
 
 #define MEAN_GLOBAL_TEMP 15
+#define OB_HISTORY_LENGTH 10     // past states kept (at least), for oscillating()
 
 namespace Hector {
 
@@ -42,11 +43,12 @@ private:
 	unitval CarbonToAdd;
 	std::vector<oceanbox*> connection_list;  //<! a vector of ocean box pointers
 	std::vector<double> connection_k;        //<! a vector of ocean k values (fraction)
-	std::vector<double> carbonHistory;       //<! a vector of past C states
-   	std::vector<double> carbonLossHistory;   //<! a vector of past C losses
+	std::vector<double> carbonHistory;       //<! a vector of past C states (most recent first)
+   	std::vector<double> carbonLossHistory;   //<! a vector of past C losses (most recent first)
 	std::vector<int> connection_window;      //<! a vector of connection windows to average over
 
-    double vectorHistoryMean( std::vector<double> v, int lookback ) const;
+    double vectorHistoryMean( const std::vector<double>& v, int lookback ) const;
+    void add_history( std::vector<double>& v, double x ) const;
 
     unitval compute_connection_flux( int i, double yf ) const;
 
@@ -0,0 +1,82 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2014-2015  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef SCENARIO_BUNDLE_H
+#define SCENARIO_BUNDLE_H
+/*
+ *  scenario_bundle.hpp
+ *  hector
+ *
+ *  Precompiled binary scenarios.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+#include "h_exception.hpp"
+
+#define SCENARIO_BUNDLE_MAGIC "HSCNBIN1"    //!< first 8 bytes of every bundle
+#define SCENARIO_BUNDLE_VERSION 1
+#define SCENARIO_BUNDLE_EXTENSION ".hsb"
+
+/*!
+ * \brief Record types in a scenario bundle.
+ *
+ *  A bundle holds, in order, every setData call made while parsing a
+ *  scenario's INI file and the CSV files it refers to.  All values are in
+ *  host byte order, and every record and array starts on an 8-byte boundary
+ *  so that the file can be used in place (e.g. memory-mapped).
+ *
+ *  Header: the magic number, uint32 version, uint32 record count, uint64
+ *  offset of the string table.  Each record starts with uint32 type, uint32
+ *  component, uint32 variable, and uint32 units (string table indices; the
+ *  empty string means no units), followed by
+ *
+ *  - BUNDLE_STRING_RECORD: double date, uint32 value (string index), uint32
+ *    padding.  Used for undated values and anything that isn't a number.
+ *  - BUNDLE_SERIES_RECORD: uint32 n, uint32 padding, double dates[n], double
+ *    values[n].  A run of numeric, dated values for one variable.
+ *
+ *  String table: uint32 count, then for each string a uint32 length and the
+ *  characters.
+ */
+#define BUNDLE_STRING_RECORD 1
+#define BUNDLE_SERIES_RECORD 2
+
+namespace Hector {
+
+class Core;
+struct recorded_input;
+
+void writeScenarioBundle( const std::vector<recorded_input>& inputs,
+                          const std::string& filename );
+
+/*! \brief Sends the inputs stored in a scenario bundle to the core.
+ *
+ *  The counterpart of INIToCoreReader for scenarios compiled with
+ *  hector-bundle.  The core sees the same sequence of setData calls it
+ *  would get from the original INI file, but numeric time series arrive
+ *  as unitvals, so there is no text or CSV parsing.
+ */
+class BundleToCoreReader {
+public:
+    BundleToCoreReader( Core* core );
+
+    void parse( const std::string& filename );
+
+    static bool isBundle( const std::string& filename );
+
+private:
+    //! Weak reference to a Core object that will handle the inputs
+    Core* core;
+};
+
+}
+
+#endif // SCENARIO_BUNDLE_H
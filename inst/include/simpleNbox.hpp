@@ -16,8 +16,11 @@
 #include "temperature_component.hpp"
 #include "ocean_component.hpp"
 #include "tseries.hpp"
+#include "history_tseries.hpp"
+#include "biome_tvector.hpp"
 #include "unitval.hpp"
 #include "carbon-cycle-model.hpp"
+#include "dual.hpp"
 
 #define SNBOX_ATMOS 0
 #define SNBOX_VEG 1
@@ -31,6 +34,12 @@
 
 namespace Hector {
 
+//! The land parameters that SimpleNbox's land derivatives are with respect to
+enum land_param { LAND_BETA, LAND_Q10_RH, LAND_NPARAMS };
+
+//! A land quantity with its derivatives with respect to beta and q10_rh
+typedef dual<LAND_NPARAMS> land_dual;
+
 /*! \brief The simple global carbon model, not including the ocean
  *
  *  SimpleNbox tracks atmosphere (1 pool), land (3 pools), ocean (1 pool from its p.o.v.),
@@ -77,6 +86,11 @@ public:
     void slowparameval( double t, const double c[] );
     void stashCValues( double t, const double c[] );
     void record_state(double t);                        //!< record the state variables at the end of the time step
+    void getSpinupState( std::vector<double>& x ) const;
+    bool setSpinupState( const std::vector<double>& x );
+    bool prescribedAtmosphere( double t ) const;
+
+    land_dual getLandGradient( const std::string& varName, const double date ) const;
 
     void createBiome(const std::string& biome);
     void deleteBiome(const std::string& biome);
@@ -120,17 +134,17 @@ private:
      * a reset, we will retrieve the state at the reset time from these
      * arrays.
      *****************************************************************/
-    tseries<unitval> earth_c_ts;  //!< Time series of earth carbon pool
-    tseries<unitval> atmos_c_ts;  //!< Time series of atmosphere carbon pool
-    tseries<unitval> Ca_ts;       //!< Time series of atmosphere CO2 concentration
+    history_tseries earth_c_ts;  //!< Time series of earth carbon pool
+    history_tseries atmos_c_ts;  //!< Time series of atmosphere carbon pool
+    history_tseries Ca_ts;       //!< Time series of atmosphere CO2 concentration
 
-    tvector<unitval_stringmap> veg_c_tv;      //!< Time series of biome-specific vegetation carbon pools
-    tvector<unitval_stringmap> detritus_c_tv; //!< Time series of biome-specific detritus carbon pools
-    tvector<unitval_stringmap> soil_c_tv;     //!< Time series of biome-specific soil carbon pools
+    biome_tvector<unitval> veg_c_tv;      //!< Time series of biome-specific vegetation carbon pools
+    biome_tvector<unitval> detritus_c_tv; //!< Time series of biome-specific detritus carbon pools
+    biome_tvector<unitval> soil_c_tv;     //!< Time series of biome-specific soil carbon pools
 
-    tseries<unitval> residual_ts; //!< Time series of residual flux values
+    history_tseries residual_ts; //!< Time series of residual flux values
 
-    tvector<double_stringmap> tempfertd_tv, tempferts_tv; //!< Time series of temperature effect on respiration
+    biome_tvector<double> tempfertd_tv, tempferts_tv; //!< Time series of temperature effect on respiration
 
 
     /*****************************************************************
@@ -146,7 +160,75 @@ private:
     double tcurrent;                    //!< Current time (last completed time step)
     double masstot;                     //!< tracker for mass conservation
     unitval atmosland_flux;             //!< Atmosphere -> land C flux
-    tseries<unitval> atmosland_flux_ts; //!< Atmosphere -> land C flux (time series)
+    history_tseries atmosland_flux_ts; //!< Atmosphere -> land C flux (time series; for output
+                                       //!< only, so it may be stored in single precision)
+
+    /*****************************************************************
+     * Land fluxes
+     * The land fluxes are sums over biomes.  The biome parameters and
+     * state they depend on are kept in parallel arrays (in biome_list
+     * order), and sum_land_fluxes() computes each biome's fluxes and
+     * the totals in one pass, at the start of each solver step and
+     * whenever the pools change.  calcderivs uses the totals as they
+     * are, since they don't depend on the solver's pools.
+     *****************************************************************/
+
+    //! Per-biome arrays for the land fluxes
+    struct biome_arrays {
+        // Parameters, copied from the maps
+        std::vector<double> npp_flux0, beta, q10_rh, warmingfactor;
+        std::vector<double> f_nppv, f_nppd, f_litterd;
+
+        // State, and where it lives in the maps
+        std::vector<double> veg_c, detritus_c, soil_c;
+        std::vector<double> co2fert, tempfertd, tempferts;
+        std::vector<unitval*> veg_c_p, detritus_c_p, soil_c_p;
+        std::vector<double*> co2fert_p, tempfertd_p, tempferts_p;
+
+        // Fluxes, Pg C/yr
+        std::vector<double> npp, rh;
+    };
+
+    //! Land fluxes summed over biomes, Pg C/yr
+    template<class T>
+    struct land_fluxes_t {
+        T npp, npp_fav, npp_fad, npp_fas;   //!< NPP, and its parts to vegetation, detritus, soil
+        T rh, rh_fda, rh_fsa;               //!< heterotrophic respiration, from detritus, from soil
+        T litter, litter_fvd, litter_fvs;   //!< litter flux, and its parts to detritus, soil
+        T detsoil;                          //!< detritus to soil flux
+    };
+    typedef land_fluxes_t<double> land_fluxes;
+
+    biome_arrays biome_data;            //!< biome parameters and state for the land fluxes
+    land_fluxes land;                   //!< land fluxes for the current state
+    bool biomes_packed;                 //!< are biome_data's parameters and pointers current?
+
+    /*****************************************************************
+     * Land derivatives
+     * The land pools and atmosphere-land flux, with their derivatives
+     * with respect to beta and q10_rh (every biome's value moving
+     * together), from the same flux code run on land_duals.  Other
+     * inputs to the land (Ca, temperature) are held fixed, so the
+     * derivatives are exact where atmospheric CO2 is constrained.
+     * They are only computed if land_gradient is set (before the run).
+     *****************************************************************/
+
+    bool land_gradient;                         //!< compute the land derivatives?
+
+    //! The land derivatives for the current state
+    struct land_tangents {
+        std::vector<land_dual> veg_c, detritus_c, soil_c;       //!< biome pools, Pg C
+        std::vector<land_dual> tempferts;                       //!< soil temperature effect
+        land_dual atmosland_flux;                               //!< atmosphere -> land C flux, Pg C/yr
+    };
+
+    land_tangents tangent;                      //!< land derivatives for the current state
+    std::vector<double> tangent_dates;          //!< dates of the recorded land derivatives
+    std::vector<land_dual> tangent_history;     //!< recorded land derivatives: for each date, the
+                                                //!< biome veg_c, detritus_c, soil_c, and tempferts,
+                                                //!< then atmosland_flux
+    std::vector<land_dual> co2fert_d, tempfertd_d, npp_d, rh_d; //!< biome factors and fluxes, as duals
+    land_fluxes_t<land_dual> land_d;            //!< land fluxes for the current state, as duals
     
     /*****************************************************************
      * Input data
@@ -157,12 +239,15 @@ private:
     // Carbon fluxes
     tseries<unitval> ffiEmissions;  //!< fossil fuels and industry emissions, Pg C/yr
     tseries<unitval> lucEmissions;      //!< land use change emissions, Pg C/yr
+    interp_interval ffi_interval;   //!< ffiEmissions over the current time step, Pg C/yr
+    interp_interval luc_interval;   //!< lucEmissions over the current time step, Pg C/yr
 
     // Albedo
     tseries<unitval> Ftalbedo;   //!< terrestrial albedo forcing, W/m2
 
     // Constraints
     tseries<unitval> CO2_constrain;      //!< input [CO2] record to constrain model to
+    double CO2_prescribed_from;          //!< first year from which CO2_constrain covers the rest of the run
 
     /*****************************************************************
      * Model parameters
@@ -204,80 +289,28 @@ private:
      * Private helper functions
      *****************************************************************/
     void sanitychecks();                                //!< performs mass-balance and other checks
-    unitval sum_map( unitval_stringmap pool ) const;    //!< sums a unitval map (collection of data)
-    double sum_map( double_stringmap pool ) const;      //!< sums a double map (collection of data)
+    unitval sum_map( const unitval_stringmap& pool ) const; //!< sums a unitval map (collection of data)
+    double sum_map( const double_stringmap& pool ) const;   //!< sums a double map (collection of data)
     void log_pools( const double t );                   //!< prints pool status to the log file
     void set_c0(double newc0);                          //!< set initial co2 and adjust total carbon mass
+    void pack_biomes();                                 //!< fills biome_data's parameters and pointers
+    void sum_land_fluxes();                             //!< computes the land fluxes from biome_data
+    void sum_land_tangents();                           //!< computes land_d from the land derivatives
+    void stash_land_tangents( const double yf, const double veg_delta,
+                              const double det_delta, const double soil_delta ); //!< updates the land derivatives
+    size_t tangent_record( const double date ) const;   //!< where a date's land derivatives are recorded
+    void extend_co2_prescribed( double date );          //!< moves CO2_prescribed_from back from date
+
+    template<class T>
+    static void biome_fluxes( const biome_arrays& b, const size_t nbiomes,
+                              const T veg[], const T det[], const T soil[],
+                              const T co2fert[], const T tempfertd[], const T tempferts[],
+                              land_fluxes_t<T>& f, T npp[], T rh[] );
 
     bool has_biome(const std::string& biome);
 
     CarbonCycleModel *omodel;           //!< pointer to the ocean model in use
 
-    // Add a biome to a time-series map variable (e.g. veg_c_tv)
-    template <class T_data>
-    void add_biome_to_ts(tvector<std::map<std::string, T_data>>& ts,
-                         const std::string& biome,
-                         T_data init_value) {
-        // First, check if a biome of this name already exists in the data
-        if ( ts.get(ts.firstdate()).count( biome ) ) {
-            H_THROW( "Biome '" + biome + "' already exists in data." );
-        }
-
-        // Loop over time steps, and set the variable to the provided `init_value`
-        std::map<std::string, T_data> newval;
-        for ( double i = ts.firstdate(); i < ts.lastdate(); i++ ) {
-            if (ts.exists(i)) {
-                newval = ts.get(i);
-                newval[ biome ] = init_value;
-                ts.set(i, newval);
-            }
-        }
-    }
-
-    // Remove a biome from a time-series map variable
-    template <class T_map>
-    void remove_biome_from_ts(tvector<T_map>& ts,
-                              const std::string& biome) {
-        // We don't need to check for presence of `biome` here because the
-        // `<std::map>.erase()` method is effectively a no-op when given a
-        // non-existent key.
-        T_map currval;
-        for ( double i = ts.firstdate(); i < ts.lastdate(); i++ ) {
-            if (ts.exists(i)) {
-                currval = ts.get(i);
-                currval.erase(biome);
-                ts.set(i, currval);
-            }
-        }
-    }
-
-    // Rename a biome in a time-series map variable. At each time
-    // step, this creates a new biome called `newname`, gives it all
-    // of the values of `oldname`, and then erases that time step's
-    // `oldname`.
-    template <class T_map>
-    void rename_biome_in_ts(tvector<T_map>& ts,
-                            const std::string& oldname,
-                            const std::string& newname) {
-        if ( !ts.get(ts.firstdate()).count( oldname ) ) {
-            H_THROW( "Biome '" + oldname + "' not found in data.");
-        }
-        if ( ts.get(ts.firstdate()).count( newname ) ) {
-            H_THROW( "Biome '" + newname + "' already exists in data.");
-        }
-
-        T_map currval;
-        for ( double i = ts.firstdate(); i < ts.lastdate(); i++ ) {
-            if (ts.exists(i)) {
-                currval = ts.get(i);
-                currval[newname] = currval.at(oldname);
-                currval.erase(oldname);
-                ts.set(i, currval);
-            }
-        }
-    }
-
-
 };
 
 }
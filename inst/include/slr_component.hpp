@@ -16,7 +16,7 @@
 
 #include "imodel_component.hpp"
 #include "logger.hpp"
-#include "tseries.hpp"
+#include "history_tseries.hpp"
 #include "unitval.hpp"
 
 // Need to forward declare the components which depend on each other
@@ -67,18 +67,19 @@ private:
     virtual unitval getData( const std::string& varName,
                             const double valueIndex );
 
-    tseries<unitval>	sl_rc;			//!< sea level rate of change, cm/yr
-    tseries<unitval>	slr;			//!< sea level rise, cm
-    tseries<unitval>	sl_rc_no_ice;   //!< sea level rate of change, cm/yr, no ice
-    tseries<unitval>	slr_no_ice;		//!< sea level rise, cm, no ice
+    history_tseries	sl_rc;			//!< sea level rate of change, cm/yr (output only)
+    history_tseries	slr;			//!< sea level rise, cm
+    history_tseries	sl_rc_no_ice;   //!< sea level rate of change, cm/yr, no ice (output only)
+    history_tseries	slr_no_ice;		//!< sea level rise, cm, no ice
 
     unitval             refperiod_tgav;	//!< reference period mean temperature
-    tseries<unitval>    tgav;           //!< private copy of global mean temperature
+    history_tseries     tgav;           //!< private copy of global mean temperature
 
     //! pointers to other components and stuff
     Core *core;
 
     void compute_slr( const double date );
+    double tgav_deriv( const double date ) const;
 
     //! logger
     Logger logger;
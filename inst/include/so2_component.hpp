@@ -48,6 +48,9 @@ public:
 
     virtual void run( const double runToDate );
 
+    //! Emissions are only looked up by date, so any time step will do
+    virtual bool supportsTimestep( const double dt ) const { return true; }
+
     virtual void reset(double time);
 
     virtual void shutDown();
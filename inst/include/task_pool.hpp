@@ -0,0 +1,68 @@
+/* Hector -- A Simple Climate Model
+   Copyright (C) 2014-2015  Battelle Memorial Institute
+
+   Please see the accompanying file LICENSE.md for additional licensing
+   information.
+*/
+#ifndef TASK_POOL_H
+#define TASK_POOL_H
+/*
+ *  task_pool.hpp
+ *  hector
+ *
+ *  A small pool of threads for running independent tasks.
+ *
+ */
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Hector {
+
+//------------------------------------------------------------------------------
+/*! \brief Runs batches of independent tasks on a fixed set of threads.
+ *
+ *  The thread calling run() works on the batch too, so a pool for n threads
+ *  starts n-1 of its own.  run() returns when every task in the batch has
+ *  finished.  If any tasks threw, the exception from the first of them (by
+ *  index, not by time) is rethrown, so errors don't depend on scheduling.
+ */
+class TaskPool {
+public:
+    TaskPool( int nthreads );
+    ~TaskPool();
+
+    int size() const { return static_cast<int>( workers.size() ) + 1; }
+
+    void run( size_t ntasks, const std::function<void( size_t )>& task );
+
+private:
+    TaskPool( const TaskPool& );
+    TaskPool& operator=( const TaskPool& );
+
+    void work();
+    void drain();
+
+    std::vector<std::thread> workers;
+
+    //! Protects everything below
+    std::mutex poolMutex;
+    std::condition_variable batchReady;
+    std::condition_variable batchDone;
+
+    const std::function<void( size_t )>* batch;
+    size_t batchSize;
+    size_t nextTask;
+    size_t unfinished;
+    unsigned long generation;       //!< incremented for each batch
+    bool stopping;
+    std::vector<std::exception_ptr> errors;
+};
+
+}
+
+#endif // TASK_POOL_H
@@ -46,6 +46,7 @@ public:
     void set( double, T_data );
     T_data get( double ) const;
     T_data get_deriv( double ) const;
+    interp_interval get_interval( double ) const;
     bool exists( double ) const;
 
     double firstdate() const;
@@ -79,7 +80,7 @@ struct interp_helper {
     // TODO: we might want to consider re-organizing this to not have to pass
     // info around, discuss with Ben
     static void error_check( const std::map<double, T_data>& userData,
-                             h_interpolator& interpolator, std::string name,
+                             h_interpolator& interpolator, const std::string& name,
                              bool& isDirty, bool endinterp_allowed,
                              const double index )
     {
@@ -108,7 +109,7 @@ struct interp_helper {
             H_ASSERT( endinterp_allowed, "In time series '" + name + "', end interpolation not allowed" );
     }
     static T_data interp( const std::map<double, T_data>& userData,
-                          h_interpolator& interpolator, std::string name,
+                          h_interpolator& interpolator, const std::string& name,
                           bool& isDirty, bool endinterp_allowed,
                           const double index )
     {
@@ -117,7 +118,7 @@ struct interp_helper {
         return interpolator.f( index );
     }
     static T_data calc_deriv( const std::map<double, T_data>& userData,
-                              h_interpolator& interpolator, std::string name,
+                              h_interpolator& interpolator, const std::string& name,
                               bool& isDirty, bool endinterp_allowed,
                               const double index )
     {
@@ -125,6 +126,15 @@ struct interp_helper {
 
         return interpolator.f_deriv( index );
     }
+    static void interval( const std::map<double, T_data>& userData,
+                          h_interpolator& interpolator, const std::string& name,
+                          bool& isDirty, bool endinterp_allowed,
+                          const double index, interp_interval& iv )
+    {
+        error_check( userData, interpolator, name, isDirty, endinterp_allowed, index );
+
+        interpolator.interval( index, iv );
+    }
 };
 
 
@@ -142,7 +152,7 @@ struct interp_helper<unitval> {
     // TODO: we might want to consider re-organizing this to not have to pass
     // info around, discuss with Ben
     static void error_check( const std::map<double, T_unit_type>& userData,
-                             h_interpolator& interpolator, std::string name,
+                             h_interpolator& interpolator, const std::string& name,
                              bool& isDirty, bool endinterp_allowed,
                              const double index )
     {
@@ -171,7 +181,7 @@ struct interp_helper<unitval> {
             H_ASSERT( endinterp_allowed, "end interpolation not allowed" );
     }
     static T_unit_type interp( const std::map<double, T_unit_type>& userData,
-                               h_interpolator& interpolator, std::string name,
+                               h_interpolator& interpolator, const std::string& name,
                                bool& isDirty, bool endinterp_allowed,
                                const double index )
     {
@@ -180,7 +190,7 @@ struct interp_helper<unitval> {
         return unitval( interpolator.f( index ), (*(userData.begin())).second.units() );
     }
     static T_unit_type calc_deriv( const std::map<double, T_unit_type>& userData,
-                                   h_interpolator& interpolator, std::string name,
+                                   h_interpolator& interpolator, const std::string& name,
                                    bool& isDirty, bool endinterp_allowed,
                                    const double index )
     {
@@ -188,6 +198,15 @@ struct interp_helper<unitval> {
 
         return unitval( interpolator.f_deriv( index ), (*(userData.begin())).second.units() );
     }
+    static void interval( const std::map<double, T_unit_type>& userData,
+                          h_interpolator& interpolator, const std::string& name,
+                          bool& isDirty, bool endinterp_allowed,
+                          const double index, interp_interval& iv )
+    {
+        error_check( userData, interpolator, name, isDirty, endinterp_allowed, index );
+
+        interpolator.interval( index, iv );
+    }
 };
 
 
@@ -285,6 +304,27 @@ T_data tseries<T_data>::get_deriv( double t ) const {
     }
 }
 
+//-----------------------------------------------------------------------
+/*! \brief The interpolating function between the dates around time t.
+ *
+ *  For getting many values between two neighbouring dates (e.g. within a
+ *  model time step) without a lookup for each; inside the interval, its
+ *  f() gives the same values as get().  The interval is empty if t isn't
+ *  within the data, or interpolation isn't allowed over the interval.
+ */
+template <class T_data>
+interp_interval tseries<T_data>::get_interval( double t ) const {
+    interp_interval iv;
+    if( mapdata.size() > 1 && t >= firstdate() && t < lastdate() ) {
+        interp_helper<T_data>::interval( mapdata,
+                                         const_cast<tseries*>( this )->interpolator,
+                                         name, dirty, endinterp_allowed, t, iv );
+        if( iv.x1 > lastInterpYear )
+            iv = interp_interval();
+    }
+    return iv;
+}
+
 //-----------------------------------------------------------------------
 /*! \brief Set interpolation policies for data.
  *
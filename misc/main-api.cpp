@@ -11,11 +11,13 @@
  */
 
 #include <stdlib.h>
+#include <math.h>
 #include <iostream>
 #include <fstream>
 #include "boost/algorithm/string.hpp"
 
 #include "core.hpp"
+#include "core_coupler.hpp"
 #include "logger.hpp"
 #include "h_exception.hpp"
 #include "h_util.hpp"
@@ -33,7 +35,15 @@
 using namespace std;
 using namespace Hector;
 
-void read_and_set_co2(double tlast,double t, Core &core, istream &sim_gcam_emiss);
+// Emissions passed to the core on each coupling step, and their units
+const char *emiss_names[] = {D_FFI_EMISSIONS, D_LUC_EMISSIONS, D_EMISSIONS_SO2, D_EMISSIONS_BC,
+                             D_EMISSIONS_OC, D_EMISSIONS_CF4, D_EMISSIONS_HCF22};
+const unit_types emiss_units[] = {U_PGC_YR, U_PGC_YR, U_GG_S, U_TG, U_TG, U_GG, U_GG};
+const int emiss_cols[] = {1, 2, 6, 10, 11, 13, 32}; // columns in the emissions file
+const int nemiss = sizeof emiss_names / sizeof emiss_names[0];
+const int nstep = 5;                                  // years per coupling step
+
+void read_co2(double tlast, double t, double *emiss, istream &sim_gcam_emiss);
 void init_emiss_strm(istream &sim_gcam_emiss);
 
 //-----------------------------------------------------------------------
@@ -97,20 +107,33 @@ int main (int argc, char * const argv[]) {
         ifstream sim_gcam_emiss("input/emissions/RCP6_emissions.csv");
         init_emiss_strm(sim_gcam_emiss);
 
+        // Register the inputs we will pass in and the outputs we want back.
+        // Note you don't need to get the name of the component; you just
+        // need to say what kind of data you want, and the core takes care
+        // of the rest.  The handles returned are the column numbers in the
+        // input and output buffers.
+        CoreCoupler coupler(&core);
+        for(int i=0; i<nemiss; ++i)
+            coupler.addInput(emiss_names[i], emiss_units[i]);
+        const int itemp = coupler.addOutput(D_GLOBAL_TEMP, U_DEGC);
+        const int ica   = coupler.addOutput(D_ATMOSPHERIC_CO2, U_PPMV_CO2);
+        const int iforc = coupler.addOutput(D_RF_TOTAL, U_W_M2);
+        double emiss[nstep * nemiss];
+        double outputs[nstep * 3];
+
         tseries<unitval> tempts;
         tseries<unitval> cats;
         tseries<unitval> forcts;
         
-        for(double t=core.getStartDate()+5.0; t<=core.getEndDate(); t+=5.0) {
-            read_and_set_co2(tlast, t, core, sim_gcam_emiss);
-            core.run(t);
-            // The following provide an example of how to request data
-            // from components.  Note you don't need to get the name
-            // of the component; you just need to say what kind of
-            // data you want, and the core takes care of the rest.
-            unitval temp = core.sendMessage(M_GETDATA, D_GLOBAL_TEMP);
-            unitval ca   = core.sendMessage(M_GETDATA, D_ATMOSPHERIC_CO2);
-            unitval forc = core.sendMessage(M_GETDATA, D_RF_TOTAL);
+        for(double t=core.getStartDate()+nstep; t<=core.getEndDate(); t+=nstep) {
+            read_co2(tlast, t, emiss, sim_gcam_emiss);
+            coupler.step(nstep, emiss, outputs);
+
+            // outputs has one row per year of the step; we report the last.
+            const double *last = outputs + (nstep-1) * coupler.numOutputs();
+            unitval temp(last[itemp], U_DEGC);
+            unitval ca(last[ica], U_PPMV_CO2);
+            unitval forc(last[iforc], U_W_M2);
             H_LOG(glog, Logger::NOTICE)
                 << "t= " << t << "\t"
                 << "temp= " << temp << "\t"
@@ -126,7 +149,7 @@ int main (int argc, char * const argv[]) {
         }
 
         // Reset the model to five years after the start date and
-        // rerun.  We don't have to call read_and_set_co2 again
+        // rerun.  We don't have to call read_co2 again
         // because the emissions time series aren't affected by the
         // reset.  We could, however, push new emissions into the
         // model if, for example, we wanted to run a revised scenario.
@@ -164,8 +187,12 @@ int main (int argc, char * const argv[]) {
     return 0;
 }
 
-void read_and_set_co2(double tstrt, double tend, Core &core, istream &sim_gcam_emiss)
+void read_co2(double tstrt, double tend, double *emiss, istream &sim_gcam_emiss)
 {
+    // Years we don't read a value for are NaN, which leaves the core's
+    // own emissions in place.
+    for(int n=0; n<nstep*nemiss; ++n)
+        emiss[n] = NAN;
 
     double t;
     std::string line;
@@ -174,40 +201,15 @@ void read_and_set_co2(double tstrt, double tend, Core &core, istream &sim_gcam_e
         getline(sim_gcam_emiss, line);
         boost::split(splitvec, line, boost::algorithm::is_any_of(","));
         t = atof(splitvec[0].c_str());
-        if(t>=tstrt && t>2010.0) {
-            double ffi   = atof(splitvec[1].c_str());
-            double luc   = atof(splitvec[2].c_str());
-            double so2   = atof(splitvec[6].c_str());
-            double bc    = atof(splitvec[10].c_str());
-            double oc    = atof(splitvec[11].c_str());
-            double cf4   = atof(splitvec[13].c_str());
-            double hcf22 = atof(splitvec[32].c_str());
-
-            // This is how you set annual emissions into the model
-            core.sendMessage(M_SETDATA, D_FFI_EMISSIONS,
-                             message_data(t, unitval(ffi, U_PGC_YR)));
-            core.sendMessage(M_SETDATA, D_LUC_EMISSIONS,
-                             message_data(t, unitval(luc, U_PGC_YR)));
-            core.sendMessage(M_SETDATA, D_EMISSIONS_SO2,
-                             message_data(t, unitval(so2, U_GG_S)));
-            core.sendMessage(M_SETDATA, D_EMISSIONS_BC,
-                             message_data(t, unitval(bc, U_TG)));
-            core.sendMessage(M_SETDATA, D_EMISSIONS_OC,
-                             message_data(t, unitval(oc, U_TG)));
-            core.sendMessage(M_SETDATA, D_EMISSIONS_CF4,
-                             message_data(t, unitval(cf4, U_GG)));
-            core.sendMessage(M_SETDATA, D_EMISSIONS_HCF22,
-                             message_data(t, unitval(hcf22, U_GG)));
-
-            std::cout << "t= " << t << "\n"
-                      << "\t\tffi= " << ffi << "\n"
-                      << "\t\tluc= " << luc << "\n"
-                      << "\t\tSO2= " << so2 << "\n"
-                      << "\t\tBC= "  << bc << "\n"
-                      << "\t\tOC= "  << oc << "\n"
-                      << "\t\tCF4= " << cf4 << "\n"
-                      << "\t\tHCF22= " << hcf22 << "\n"
-              ;
+        if(t>tstrt && t<=tend && t>2010.0) {
+            // This is how you set annual emissions into the model: row
+            // k of the buffer is year tstrt+k+1.
+            double *row = emiss + int(t-tstrt-1) * nemiss;
+            std::cout << "t= " << t << "\n";
+            for(int i=0; i<nemiss; ++i) {
+                row[i] = atof(splitvec[emiss_cols[i]].c_str());
+                std::cout << "\t\t" << emiss_names[i] << "= " << row[i] << "\n";
+            }
         }
     } while(t < tend);
     // when t >=  tend, we exit, leaving tend+1 in the stream to read next time.